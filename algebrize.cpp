@@ -0,0 +1,126 @@
+#include "algebrize.hpp"
+#include "fol.hpp"
+#include "nodefactory.hpp"
+#include "parsecontext.hpp"
+#include "templates.hpp"
+
+#include <sstream>
+
+/* Arena jednog poziva; po izlasku se vraca arena pozivaoca. */
+class StatementScope {
+public:
+    StatementScope()
+        :_previous(Arena::current())
+    {
+        Arena::setCurrent(&_arena);
+    }
+
+    ~StatementScope()
+    {
+        NodeFactory::clear();
+        Arena::setCurrent(_previous);
+    }
+
+private:
+    Arena _arena;
+    Arena * _previous;
+};
+
+/* Dodaje tacke atoma redom konstrukcije (vidi PolynomialSystem::variables). */
+static void addPoints(const Atom * a, vector<bool> & seen, vector<Var> & variables)
+{
+    const vector<Term> & ops = a->getOperands();
+    for(auto it = ops.rbegin(); it != ops.rend(); ++it) {
+        PointId p = (*it)->getType() == BaseTerm::TT_VARIABLE ?
+                    ((VariableTerm *)*it)->getVariable() : ((FunctionTerm *)*it)->getPoint();
+        if(p >= seen.size())
+            seen.resize(p + 1, false);
+        if(seen[p])
+            continue;
+        seen[p] = true;
+        variables.push_back(coordinateVar(p, X));
+        variables.push_back(coordinateVar(p, Y));
+    }
+}
+
+/* Skuplja jednacine konjunkcije relacija f; vraca false ako je neki
+   njen sistem protivrecan. */
+static bool collect(const Formula & f, TranslationContext & ctx, PolynomialSystem & result,
+                    vector<Polynomial> & system, vector<bool> & seen)
+{
+    switch(f->getType()){
+    case BaseFormula::T_TRUE:
+        return true;
+    case BaseFormula::T_FALSE:
+        return false;
+    case BaseFormula::T_AND:
+    {
+        // Obe strane se obilaze, da -o vidi tacke istim redom kao ispis.
+        bool consistent = collect(((And *)f)->getOperand1(), ctx, result, system, seen);
+        return collect(((And *)f)->getOperand2(), ctx, result, system, seen) && consistent;
+    }
+    case BaseFormula::T_ATOM:
+        if(dynamic_cast<Disequality *>(f) == nullptr) {
+            addPoints((Atom *)f, seen, result.variables);
+            return ((Atom *)f)->toSystem(ctx, system);
+        }
+        break;
+    default:
+        break;
+    }
+
+    throw AlgebrizeError("statement is not a conjunction of relations");
+}
+
+PolynomialSystem algebrize(BaseFormula * f, TranslationContext & ctx)
+{
+    PolynomialSystem result;
+    vector<bool> seen;
+
+    result.hasConclusion = f->getType() == BaseFormula::T_IMP;
+    if(result.hasConclusion) {
+        result.hypothesesConsistent = collect(((Imp *)f)->getOperand1(), ctx, result,
+                                              result.hypotheses, seen);
+        result.conclusionConsistent = collect(((Imp *)f)->getOperand2(), ctx, result,
+                                              result.conclusion, seen);
+    }
+    else {
+        result.hypothesesConsistent = collect(f, ctx, result, result.hypotheses, seen);
+        result.conclusionConsistent = true;
+    }
+
+    return result;
+}
+
+PolynomialSystem algebrize(string_view statement, const AlgebrizeOptions & options)
+{
+    RelationTemplate::init();
+    StatementScope scope;
+
+    ParseContext parser;
+    parser.setInput(statement.data(), statement.size());
+
+    parser.parse();
+    if(parser.exitIndicator)
+        throw AlgebrizeError("no statement");
+    if(!parser.printIndicator)
+        throw AlgebrizeError(parser.errorMessage);
+
+    Formula f = parser.parsedFormula;
+
+    parser.parse();
+    if(!parser.endOfInput)
+        throw AlgebrizeError("expected a single statement");
+
+    TranslationContext ctx(options.optimize);
+    PolynomialSystem result = algebrize(f, ctx);
+
+    if(options.renderText) {
+        TranslationContext textCtx(options.optimize, options.normalForm ? normalFormOutput : infixOutput);
+        ostringstream text;
+        f->printConvertedFormula(text, textCtx);
+        result.text = text.str();
+    }
+
+    return result;
+}
@@ -0,0 +1,81 @@
+#ifndef _ALGEBRIZE_H
+#define _ALGEBRIZE_H
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "polynomial.hpp"
+
+using namespace std;
+
+/* Biblioteka za prevod naredbi u procesu pozivaoca. Svi izvori osim
+   main.cpp cine biblioteku; ulaz je tekst jedne naredbe, a rezultat
+   su polinomi, bez pokretanja programa i bez parsiranja njegovog
+   ispisa. Funkcija se moze pozivati istovremeno iz vise niti. */
+
+/* Algebarski oblik naredbe H => C, ili samo H: hipoteze i zakljucak
+   su sistemi jednacina p = 0 u kanonskom obliku (kao u opciji -p).
+   Promenljive polinoma su koordinate tacaka (vidi printVar). */
+struct PolynomialSystem {
+    vector<Polynomial> hypotheses;
+    vector<Polynomial> conclusion;
+
+    /* Da li je statement imao zakljucak (oblik H => C). */
+    bool hasConclusion;
+
+    /* false ako je sistem protivrecan, npr. sadrzi false ili
+       relaciju koja se za date tacke svodi na c = 0, c != 0. */
+    bool hypothesesConsistent;
+    bool conclusionConsistent;
+
+    /* Koordinate tacaka redom konstrukcije. Relacije navode tacku koja
+       se konstruise prvo (is_midpoint(M, A, B)), pa se argumenti svake
+       relacije citaju od poslednjeg, a tacka dobija mesto kad se prvi
+       put pojavi; x koordinata ide pre y. Wuov metod (wu.hpp) odavde
+       bira glavne promenljive. */
+    vector<Var> variables;
+
+    /* Tekstualni prevod kao u komandnoj liniji, ako je trazen. */
+    string text;
+};
+
+class AlgebrizeOptions {
+public:
+    AlgebrizeOptions(bool optimize = false, bool normalForm = false, bool renderText = false)
+        :optimize(optimize),
+          normalForm(normalForm),
+          renderText(renderText)
+    {}
+
+    /* Kao opcija -o: prva tacka je (0, 0), a druga na y osi. */
+    bool optimize;
+
+    /* Kao opcija -p; vazi samo za text. */
+    bool normalForm;
+
+    /* Da li se popunjava PolynomialSystem::text. */
+    bool renderText;
+};
+
+/* Naredba nije ispravna ili nije konjunkcija relacija (H), odnosno
+   implikacija dve takve konjunkcije (H => C). */
+class AlgebrizeError : public runtime_error {
+public:
+    AlgebrizeError(const string & message)
+        :runtime_error(message)
+    {}
+};
+
+/* Prevodi jednu naredbu, npr. "collinear(a, b, c) => parallel(a, b, b, c);". */
+PolynomialSystem algebrize(string_view statement,
+                           const AlgebrizeOptions & options = AlgebrizeOptions());
+
+class BaseFormula;
+class TranslationContext;
+
+/* Isto za vec parsiranu naredbu, bez teksta prevoda. */
+PolynomialSystem algebrize(BaseFormula * f, TranslationContext & ctx);
+
+#endif // _ALGEBRIZE_H
@@ -0,0 +1,82 @@
+#include "arena.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+
+thread_local Arena * Arena::_current;
+
+Arena::Arena(size_t blockSize)
+    :_blockSize(blockSize),
+      _block(0),
+      _top(nullptr),
+      _end(nullptr),
+      _blockAllocations(0)
+{}
+
+Arena::~Arena()
+{
+    release();
+    for(auto & b : _blocks)
+        free(b.data);
+
+    if(_current == this)
+        _current = nullptr;
+}
+
+void * Arena::allocate(size_t size, size_t align)
+{
+    uintptr_t p = ((uintptr_t)_top + align - 1) & ~(uintptr_t)(align - 1);
+
+    if(_top == nullptr || p + size > (uintptr_t)_end) {
+        nextBlock(size + align);
+        p = ((uintptr_t)_top + align - 1) & ~(uintptr_t)(align - 1);
+    }
+
+    _top = (char *)(p + size);
+    return (void *)p;
+}
+
+void Arena::nextBlock(size_t minSize)
+{
+    // Prvo probamo sledeci vec zauzet blok koji je dovoljno veliki.
+    if(_top != nullptr)
+        _block++;
+
+    while(_block < _blocks.size() && _blocks[_block].size < minSize)
+        _block++;
+
+    if(_block >= _blocks.size()) {
+        size_t size = minSize > _blockSize ? minSize : _blockSize;
+        char * data = (char *)malloc(size);
+        if(data == nullptr)
+            throw std::bad_alloc();
+
+        _blocks.push_back({ data, size });
+        _block = _blocks.size() - 1;
+        _blockAllocations++;
+    }
+
+    _top = _blocks[_block].data;
+    _end = _top + _blocks[_block].size;
+}
+
+void Arena::release()
+{
+    for(auto it = _destructors.rbegin(); it != _destructors.rend(); ++it)
+        it->destroy(it->obj);
+    _destructors.clear();
+
+    _block = 0;
+    _top = nullptr;
+    _end = nullptr;
+}
+
+Arena * Arena::current()
+{
+    return _current;
+}
+
+void Arena::setCurrent(Arena * arena)
+{
+    _current = arena;
+}
@@ -0,0 +1,84 @@
+#ifndef _ARENA_H
+#define _ARENA_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/* Arena (bump) alokator. Svi cvorovi jedne naredbe (jedan ciklus
+   yyparse + doTheMagic u main.cpp) se prave iz njene arene i oslobadjaju
+   se odjednom pozivom release(). Blokovi memorije se cuvaju izmedju
+   naredbi, pa u ustaljenom radu nema novih alokacija na hipu. */
+class Arena {
+public:
+    Arena(size_t blockSize = 64 * 1024);
+    ~Arena();
+
+    Arena(const Arena &) = delete;
+    Arena & operator = (const Arena &) = delete;
+
+    void * allocate(size_t size, size_t align = alignof(std::max_align_t));
+
+    template<typename T, typename... Args>
+    T * make(Args &&... args)
+    {
+        T * obj = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        if(!std::is_trivially_destructible<T>::value)
+            _destructors.push_back({ &destroy<T>, obj });
+        return obj;
+    }
+
+    /* Poziva destruktore svih objekata i vraca arenu na pocetak.
+       Zauzeti blokovi ostaju za sledecu naredbu. */
+    void release();
+
+    /* Broj blokova zatrazenih od sistema od pocetka rada. */
+    size_t blockAllocations() const
+    {
+        return _blockAllocations;
+    }
+
+    /* Arena u koju se trenutno smestaju cvorovi (vidi makeNode).
+       Svaka nit ima svoju tekucu arenu. */
+    static Arena * current();
+    static void setCurrent(Arena * arena);
+
+private:
+    struct Block {
+        char * data;
+        size_t size;
+    };
+
+    struct Destructor {
+        void (*destroy)(void *);
+        void * obj;
+    };
+
+    template<typename T>
+    static void destroy(void * obj)
+    {
+        static_cast<T *>(obj)->~T();
+    }
+
+    void nextBlock(size_t minSize);
+
+    size_t _blockSize;
+    std::vector<Block> _blocks;
+    size_t _block;
+    char * _top;
+    char * _end;
+    std::vector<Destructor> _destructors;
+    size_t _blockAllocations;
+
+    static thread_local Arena * _current;
+};
+
+template<typename T, typename... Args>
+T * makeNode(Args &&... args)
+{
+    return Arena::current()->make<T>(std::forward<Args>(args)...);
+}
+
+#endif // _ARENA_H
@@ -0,0 +1,244 @@
+#include "batch.hpp"
+#include "nodefactory.hpp"
+#include "parsecontext.hpp"
+#include "sink.hpp"
+
+#include <cctype>
+#include <cstring>
+
+/* Kljucne reci skenera (lexer.lpp); sva ostala imena su imena tacaka. */
+static const char * keywords[] = {
+    "exit", "true", "false",
+    "collinear", "parallel", "perpendicular", "lengths_eq",
+    "is_midpoint", "is_intersection", "is_equal"
+};
+
+/* Dodeljuje identifikatore imenima tacaka iz bloka istim redom kao
+   skener u obicnom rezimu, pre nego sto blok dobije neka nit. Tako ni
+   identifikatori ni ispis (npr. redosled promenljivih u -p) ne zavise
+   od rasporeda niti. */
+static void internNames(const char * s, size_t length)
+{
+    const char * end = s + length;
+    while(s != end) {
+        if(!isalpha((unsigned char)*s)) {
+            s++;
+            continue;
+        }
+
+        const char * begin = s;
+        while(s != end && (isalnum((unsigned char)*s) || *s == '_'))
+            s++;
+
+        string_view name(begin, s - begin);
+        bool keyword = false;
+        for(const char * k : keywords)
+            if(name == k) {
+                keyword = true;
+                break;
+            }
+
+        if(!keyword)
+            SymbolTable::intern(name);
+    }
+}
+
+BatchTranslator::BatchTranslator(unsigned jobs, bool optIndicator, outputFormat format)
+    :_optIndicator(optIndicator),
+      _format(format),
+      _window(4 * jobs),
+      _done(false),
+      _in(nullptr),
+      _text(nullptr),
+      _textEnd(nullptr),
+      _eof(false)
+{
+    for(unsigned i = 0; i < jobs; i++)
+        _threads.push_back(thread(&BatchTranslator::worker, this));
+}
+
+BatchTranslator::~BatchTranslator()
+{
+    {
+        lock_guard<mutex> lock(_mutex);
+        _done = true;
+        _blocks.clear();
+    }
+    _blockReady.notify_all();
+
+    for(auto & t : _threads)
+        t.join();
+}
+
+void BatchTranslator::worker()
+{
+    // Svaka nit ima svoju arenu, svoj parser i svoj bafer za ispis.
+    Arena arena;
+    Arena::setCurrent(&arena);
+    ParseContext ctx;
+    MemorySink buffer;
+    ostream out(&buffer);
+
+    while(true) {
+        Block block;
+        {
+            unique_lock<mutex> lock(_mutex);
+            _blockReady.wait(lock, [this] { return _done || !_blocks.empty(); });
+            if(_blocks.empty())
+                return;
+            block = move(_blocks.front());
+            _blocks.pop_front();
+        }
+
+        Slot slot;
+        if(block.text == nullptr)
+            translate(ctx, block.owned.data(), block.owned.size(), out, slot);
+        else
+            translate(ctx, block.text, block.length, out, slot);
+        slot.output = buffer.take();
+
+        {
+            lock_guard<mutex> lock(_mutex);
+            _window[block.seq % _window.size()] = move(slot);
+        }
+        _slotReady.notify_one();
+    }
+}
+
+void BatchTranslator::translate(ParseContext & ctx, const char * text, size_t length,
+                                ostream & out, Slot & slot)
+{
+    slot.ready = true;
+    slot.exit = false;
+
+    ctx.setInput(text, length);
+    while(true) {
+        ctx.parse();
+
+        if(ctx.exitIndicator) {
+            slot.exit = !ctx.endOfInput;
+            break;
+        }
+
+        if(ctx.printIndicator)
+            ctx.parsedFormula->doTheMagic(_optIndicator, _format, out);
+        else
+            printStatementError(ctx.errorMessage, _format, out);
+
+        NodeFactory::clear();
+        Arena::current()->release();
+    }
+
+    NodeFactory::clear();
+    Arena::current()->release();
+}
+
+bool BatchTranslator::readBlock(Block & block)
+{
+    if(_in == nullptr) {
+        if(_text == _textEnd)
+            return false;
+
+        // Blok je bar blockSize bajtova i zavrsava se prvim ';' iza toga.
+        const char * cut = _textEnd;
+        if((size_t)(_textEnd - _text) > blockSize) {
+            cut = (const char *)memchr(_text + blockSize, ';', _textEnd - _text - blockSize);
+            cut = cut == nullptr ? _textEnd : cut + 1;
+        }
+
+        block.text = _text;
+        block.length = cut - _text;
+        _text = cut;
+        return true;
+    }
+
+    size_t cut = _pending.rfind(';');
+
+    while(!_eof && (cut == string::npos || _pending.size() < blockSize)) {
+        size_t size = _pending.size();
+        _pending.resize(size + blockSize);
+        size_t n = fread(&_pending[size], 1, blockSize, _in);
+        _pending.resize(size + n);
+
+        if(n < blockSize)
+            _eof = true;
+
+        cut = _pending.rfind(';');
+    }
+
+    if(_pending.empty())
+        return false;
+
+    // Na kraju ulaza ostatak (i bez ';') cini poslednji blok.
+    if(_eof)
+        cut = _pending.size() - 1;
+
+    block.text = nullptr;
+    block.owned.assign(_pending, 0, cut + 1);
+    _pending.erase(0, cut + 1);
+    return true;
+}
+
+void BatchTranslator::run(FILE * in, ostream & ostr)
+{
+    _in = in;
+    translateAll(ostr);
+}
+
+void BatchTranslator::run(const char * text, size_t length, ostream & ostr)
+{
+    _in = nullptr;
+    _text = text;
+    _textEnd = text + length;
+    translateAll(ostr);
+}
+
+void BatchTranslator::translateAll(ostream & ostr)
+{
+    size_t read = 0;
+    size_t written = 0;
+    bool eof = false;
+
+    while(true) {
+        // Citamo unapred dok ima mesta u baferu za preuredjivanje.
+        while(!eof && read - written < _window.size()) {
+            Block block;
+            if(!readBlock(block)) {
+                eof = true;
+                break;
+            }
+
+            block.seq = read;
+            if(block.text == nullptr)
+                internNames(block.owned.data(), block.owned.size());
+            else
+                internNames(block.text, block.length);
+
+            {
+                lock_guard<mutex> lock(_mutex);
+                _window[read % _window.size()].ready = false;
+                _blocks.push_back(move(block));
+            }
+            _blockReady.notify_one();
+            read++;
+        }
+
+        if(written == read)
+            break;
+
+        Slot slot;
+        {
+            unique_lock<mutex> lock(_mutex);
+            Slot & next = _window[written % _window.size()];
+            _slotReady.wait(lock, [&next] { return next.ready; });
+            slot = move(next);
+        }
+
+        ostr << slot.output;
+        written++;
+
+        // Naredbe iza exit se ne prevode.
+        if(slot.exit)
+            break;
+    }
+}
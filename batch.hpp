@@ -0,0 +1,88 @@
+#ifndef _BATCH_H
+#define _BATCH_H
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "fol.hpp"
+
+using namespace std;
+
+class ParseContext;
+
+/* Paketni rezim (--jobs N). Ulaz se deli na blokove celih naredbi
+   (blok se uvek zavrsava znakom ';'), blokove prevodi N niti, a
+   prevodi se ispisuju redosledom kojim su blokovi procitani: prevod
+   bloka ceka u baferu za preuredjivanje dok se ne ispisu svi raniji.
+   Ispis je isti kao u obicnom rezimu. */
+class BatchTranslator {
+public:
+    BatchTranslator(unsigned jobs, bool optIndicator, outputFormat format);
+    ~BatchTranslator();
+
+    BatchTranslator(const BatchTranslator &) = delete;
+    BatchTranslator & operator = (const BatchTranslator &) = delete;
+
+    /* Prevodi naredbe iz in do naredbe exit ili kraja ulaza. */
+    void run(FILE * in, ostream & ostr);
+
+    /* Isto, za ulaz koji je vec u memoriji (npr. MappedFile); blokovi
+       se ne kopiraju dok ih ne preuzme nit. */
+    void run(const char * text, size_t length, ostream & ostr);
+
+    /* Priblizna velicina jednog bloka u bajtovima. */
+    static const size_t blockSize = 64 * 1024;
+
+private:
+    /* Blok procitan iz datoteke je u owned, a blok iz memorije je
+       samo pokazivac na ulaz. */
+    struct Block {
+        size_t seq;
+        string owned;
+        const char * text;
+        size_t length;
+    };
+
+    /* Mesto u baferu za preuredjivanje; blok seq ide na mesto
+       seq % _window.size(). */
+    struct Slot {
+        bool ready;
+        bool exit;
+        string output;
+    };
+
+    void worker();
+    void translate(ParseContext & ctx, const char * text, size_t length,
+                   ostream & out, Slot & slot);
+    void translateAll(ostream & ostr);
+    bool readBlock(Block & block);
+
+    bool _optIndicator;
+    outputFormat _format;
+
+    vector<thread> _threads;
+
+    mutex _mutex;
+    condition_variable _blockReady;
+    condition_variable _slotReady;
+    deque<Block> _blocks;
+    vector<Slot> _window;
+    bool _done;
+
+    // Ulaz je datoteka _in, ili niz [_text, _textEnd) ako je _in nullptr.
+    FILE * _in;
+    const char * _text;
+    const char * _textEnd;
+
+    // Procitan deo datoteke iza poslednjeg ';'.
+    string _pending;
+    bool _eof;
+};
+
+#endif // _BATCH_H
@@ -0,0 +1,281 @@
+#include "bigint.hpp"
+
+#include <algorithm>
+
+BigInt::BigInt(__int128 value)
+    :_negative(value < 0)
+{
+    unsigned __int128 m = value < 0 ? -(unsigned __int128)value : (unsigned __int128)value;
+    while(m != 0) {
+        _digits.push_back((uint32_t)m);
+        m >>= 32;
+    }
+}
+
+BigInt::BigInt(bool negative, Digits digits)
+    :_negative(negative),
+      _digits(move(digits))
+{
+    trim(_digits);
+    if(_digits.empty())
+        _negative = false;
+}
+
+void BigInt::trim(Digits & a)
+{
+    while(!a.empty() && a.back() == 0)
+        a.pop_back();
+}
+
+bool BigInt::toInt64(int64_t & value) const
+{
+    if(_digits.size() > 2)
+        return false;
+
+    uint64_t m = 0;
+    for(unsigned i = _digits.size(); i-- > 0; )
+        m = (m << 32) | _digits[i];
+    if(m > (uint64_t)INT64_MAX)
+        return false;
+
+    value = _negative ? -(int64_t)m : (int64_t)m;
+    return true;
+}
+
+int BigInt::compare(const Digits & a, const Digits & b)
+{
+    if(a.size() != b.size())
+        return a.size() < b.size() ? -1 : 1;
+    for(unsigned i = a.size(); i-- > 0; )
+        if(a[i] != b[i])
+            return a[i] < b[i] ? -1 : 1;
+    return 0;
+}
+
+BigInt::Digits BigInt::add(const Digits & a, const Digits & b)
+{
+    const Digits & longer = a.size() >= b.size() ? a : b;
+    const Digits & shorter = a.size() >= b.size() ? b : a;
+
+    Digits r(longer.size() + 1);
+    uint64_t carry = 0;
+    for(unsigned i = 0; i < longer.size(); i++) {
+        uint64_t s = (uint64_t)longer[i] + (i < shorter.size() ? shorter[i] : 0) + carry;
+        r[i] = (uint32_t)s;
+        carry = s >> 32;
+    }
+    r[longer.size()] = (uint32_t)carry;
+    trim(r);
+    return r;
+}
+
+/* a - b za |a| >= |b|. */
+BigInt::Digits BigInt::subtract(const Digits & a, const Digits & b)
+{
+    Digits r(a.size());
+    int64_t borrow = 0;
+    for(unsigned i = 0; i < a.size(); i++) {
+        int64_t d = (int64_t)a[i] - (i < b.size() ? b[i] : 0) - borrow;
+        borrow = d < 0;
+        r[i] = (uint32_t)d;
+    }
+    trim(r);
+    return r;
+}
+
+BigInt::Digits BigInt::multiply(const Digits & a, const Digits & b)
+{
+    if(a.empty() || b.empty())
+        return Digits();
+
+    Digits r(a.size() + b.size(), 0);
+    for(unsigned i = 0; i < a.size(); i++) {
+        uint64_t carry = 0;
+        for(unsigned j = 0; j < b.size(); j++) {
+            uint64_t t = (uint64_t)a[i] * b[j] + r[i + j] + carry;
+            r[i + j] = (uint32_t)t;
+            carry = t >> 32;
+        }
+        r[i + b.size()] = (uint32_t)carry;
+    }
+    trim(r);
+    return r;
+}
+
+/* a = a / d, vraca ostatak. */
+uint32_t BigInt::divideSmall(Digits & a, uint32_t d)
+{
+    uint64_t rem = 0;
+    for(unsigned i = a.size(); i-- > 0; ) {
+        uint64_t cur = (rem << 32) | a[i];
+        a[i] = (uint32_t)(cur / d);
+        rem = cur % d;
+    }
+    trim(a);
+    return (uint32_t)rem;
+}
+
+/* Knutov algoritam D: delilac se pomeri ulevo dok mu najvisi bit ne
+   postane 1, pa procena cifre kolicnika iz dve najvise cifre ostatka
+   gresi najvise za 2. */
+void BigInt::divide(const Digits & a, const Digits & b, Digits & q, Digits & r)
+{
+    if(compare(a, b) < 0) {
+        q.clear();
+        r = a;
+        return;
+    }
+
+    if(b.size() == 1) {
+        q = a;
+        uint32_t rem = divideSmall(q, b[0]);
+        r.clear();
+        if(rem != 0)
+            r.push_back(rem);
+        return;
+    }
+
+    const uint64_t base = (uint64_t)1 << 32;
+    unsigned n = b.size(), m = a.size() - n;
+    unsigned s = __builtin_clz(b.back());
+
+    Digits v(n), u(a.size() + 1);
+    for(unsigned i = n - 1; i > 0; i--)
+        v[i] = (b[i] << s) | (s ? (uint32_t)((uint64_t)b[i - 1] >> (32 - s)) : 0);
+    v[0] = b[0] << s;
+    u[a.size()] = s ? (uint32_t)((uint64_t)a.back() >> (32 - s)) : 0;
+    for(unsigned i = a.size() - 1; i > 0; i--)
+        u[i] = (a[i] << s) | (s ? (uint32_t)((uint64_t)a[i - 1] >> (32 - s)) : 0);
+    u[0] = a[0] << s;
+
+    q.assign(m + 1, 0);
+    for(unsigned j = m + 1; j-- > 0; ) {
+        uint64_t top = ((uint64_t)u[j + n] << 32) | u[j + n - 1];
+        uint64_t qhat = top / v[n - 1];
+        uint64_t rhat = top % v[n - 1];
+        while(qhat >= base || qhat * v[n - 2] > ((rhat << 32) | u[j + n - 2])) {
+            qhat--;
+            rhat += v[n - 1];
+            if(rhat >= base)
+                break;
+        }
+
+        int64_t borrow = 0;
+        uint64_t carry = 0;
+        for(unsigned i = 0; i < n; i++) {
+            uint64_t p = qhat * v[i] + carry;
+            carry = p >> 32;
+            int64_t t = (int64_t)u[i + j] - borrow - (int64_t)(uint32_t)p;
+            u[i + j] = (uint32_t)t;
+            borrow = t < 0;
+        }
+        int64_t t = (int64_t)u[j + n] - borrow - (int64_t)carry;
+        u[j + n] = (uint32_t)t;
+
+        // Procena je bila za jedan prevelika: vraca se jedan delilac.
+        if(t < 0) {
+            qhat--;
+            uint64_t c = 0;
+            for(unsigned i = 0; i < n; i++) {
+                uint64_t sum = (uint64_t)u[i + j] + v[i] + c;
+                u[i + j] = (uint32_t)sum;
+                c = sum >> 32;
+            }
+            u[j + n] += (uint32_t)c;
+        }
+
+        q[j] = (uint32_t)qhat;
+    }
+    trim(q);
+
+    r.assign(n, 0);
+    for(unsigned i = 0; i < n; i++)
+        r[i] = (u[i] >> s) | (s ? (uint32_t)((uint64_t)u[i + 1] << (32 - s)) : 0);
+    trim(r);
+}
+
+BigInt BigInt::operator - () const
+{
+    return BigInt(!_negative, _digits);
+}
+
+BigInt BigInt::operator + (const BigInt & b) const
+{
+    if(_negative == b._negative)
+        return BigInt(_negative, add(_digits, b._digits));
+    if(compare(_digits, b._digits) >= 0)
+        return BigInt(_negative, subtract(_digits, b._digits));
+    return BigInt(b._negative, subtract(b._digits, _digits));
+}
+
+BigInt BigInt::operator - (const BigInt & b) const
+{
+    return *this + (-b);
+}
+
+BigInt BigInt::operator * (const BigInt & b) const
+{
+    return BigInt(_negative != b._negative, multiply(_digits, b._digits));
+}
+
+BigInt BigInt::operator / (const BigInt & b) const
+{
+    Digits q, r;
+    divide(_digits, b._digits, q, r);
+    return BigInt(_negative != b._negative, move(q));
+}
+
+bool BigInt::operator < (const BigInt & b) const
+{
+    if(_negative != b._negative)
+        return _negative;
+    int c = compare(_digits, b._digits);
+    return _negative ? c > 0 : c < 0;
+}
+
+BigInt BigInt::gcd(const BigInt & a, const BigInt & b)
+{
+    Digits x = a._digits, y = b._digits, q, r;
+    while(!y.empty()) {
+        divide(x, y, q, r);
+        x.swap(y);
+        y.swap(r);
+    }
+    return BigInt(false, move(x));
+}
+
+uint32_t BigInt::magnitudeMod(uint32_t m) const
+{
+    uint64_t rem = 0;
+    for(unsigned i = _digits.size(); i-- > 0; )
+        rem = ((rem << 32) | _digits[i]) % m;
+    return (uint32_t)rem;
+}
+
+size_t BigInt::hash() const
+{
+    size_t h = _negative;
+    for(uint32_t d : _digits)
+        h = h * 0x100000001b3ULL ^ d;
+    return h;
+}
+
+string BigInt::toString() const
+{
+    if(_digits.empty())
+        return "0";
+
+    // Cifre u osnovi 10^9, od najnize.
+    Digits rest = _digits;
+    vector<uint32_t> chunks;
+    while(!rest.empty())
+        chunks.push_back(divideSmall(rest, 1000000000u));
+
+    string s = _negative ? "-" : "";
+    s += to_string(chunks.back());
+    for(unsigned i = chunks.size() - 1; i-- > 0; ) {
+        string chunk = to_string(chunks[i]);
+        s += string(9 - chunk.size(), '0') + chunk;
+    }
+    return s;
+}
@@ -0,0 +1,91 @@
+#ifndef _BIGINT_H
+#define _BIGINT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/* Ceo broj proizvoljne velicine: znak i apsolutna vrednost kao niz
+   32-bitnih cifara od najnize, bez vodecih nula (nula je prazan niz).
+   Rational ga koristi samo za vrednosti koje ne staju u 64 bita, pa
+   operacije nisu optimizovane za male brojeve. */
+class BigInt {
+public:
+    BigInt(__int128 value = 0);
+
+    bool isZero() const
+    {
+        return _digits.empty();
+    }
+
+    bool isNegative() const
+    {
+        return _negative;
+    }
+
+    bool isOne() const
+    {
+        return !_negative && _digits.size() == 1 && _digits[0] == 1;
+    }
+
+    /* Da li je |x| <= INT64_MAX; ako jeste, upisuje x u value. */
+    bool toInt64(int64_t & value) const;
+
+    BigInt operator - () const;
+    BigInt operator + (const BigInt & b) const;
+    BigInt operator - (const BigInt & b) const;
+    BigInt operator * (const BigInt & b) const;
+
+    /* Kolicnik zaokruzen ka nuli, kao kod ugradjenih tipova; b != 0. */
+    BigInt operator / (const BigInt & b) const;
+
+    bool operator == (const BigInt & b) const
+    {
+        return _negative == b._negative && _digits == b._digits;
+    }
+
+    bool operator != (const BigInt & b) const
+    {
+        return !(*this == b);
+    }
+
+    bool operator < (const BigInt & b) const;
+
+    /* Najveci zajednicki delilac, nenegativan. */
+    static BigInt gcd(const BigInt & a, const BigInt & b);
+
+    /* Ostatak |x| mod m, u [0, m). */
+    uint32_t magnitudeMod(uint32_t m) const;
+
+    size_t hash() const;
+
+    string toString() const;
+
+private:
+    typedef vector<uint32_t> Digits;
+
+    static int compare(const Digits & a, const Digits & b);
+    static Digits add(const Digits & a, const Digits & b);
+    static Digits subtract(const Digits & a, const Digits & b);
+    static Digits multiply(const Digits & a, const Digits & b);
+    static void divide(const Digits & a, const Digits & b, Digits & q, Digits & r);
+    static uint32_t divideSmall(Digits & a, uint32_t d);
+    static void trim(Digits & a);
+
+    BigInt(bool negative, Digits digits);
+
+    bool _negative;
+    Digits _digits;
+};
+
+inline
+ostream & operator << (ostream & ostr, const BigInt & b)
+{
+    return ostr << b.toString();
+}
+
+#endif // _BIGINT_H
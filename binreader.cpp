@@ -0,0 +1,181 @@
+#include "binreader.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+/* Najveca dubina formule; stiti citac od prekoracenja steka. */
+static const unsigned maxDepth = 10000;
+
+/* Najveci identifikator tacke; stiti od ogromne tabele imena. */
+static const uint64_t maxNames = 1 << 28;
+
+BinaryReader::BinaryReader(const char * data, size_t length)
+    :_s((const unsigned char *)data),
+      _end((const unsigned char *)data + length)
+{
+    if(length < sizeof(binaryMagic) || memcmp(data, binaryMagic, sizeof(binaryMagic)) != 0)
+        throw std::runtime_error("not a binary translation (bad magic)");
+    _s += sizeof(binaryMagic);
+}
+
+void BinaryReader::error() const
+{
+    throw std::runtime_error("corrupt binary translation");
+}
+
+uint64_t BinaryReader::readVarint()
+{
+    uint64_t value = 0;
+    for(unsigned shift = 0; shift < 64; shift += 7) {
+        if(_s == _end)
+            error();
+        unsigned char b = *_s++;
+        value |= (uint64_t)(b & 0x7f) << shift;
+        if((b & 0x80) == 0)
+            return value;
+    }
+    error();
+    return 0;
+}
+
+int64_t BinaryReader::readSigned()
+{
+    uint64_t z = readVarint();
+    return (int64_t)(z >> 1) ^ -(int64_t)(z & 1);
+}
+
+std::string BinaryReader::readString()
+{
+    uint64_t length = readVarint();
+    if(length > (uint64_t)(_end - _s))
+        error();
+    std::string s((const char *)_s, length);
+    _s += length;
+    return s;
+}
+
+void BinaryReader::readPolynomial(BinaryPolynomial & p)
+{
+    uint64_t terms = readVarint();
+    if(terms > (uint64_t)(_end - _s))
+        error();
+    p.resize(terms);
+
+    for(BinaryMonomial & m : p) {
+        m.num = readSigned();
+        m.den = (int64_t)readVarint();
+        if(m.den <= 0)
+            error();
+
+        uint64_t factors = readVarint();
+        if(factors > (uint64_t)(_end - _s))
+            error();
+        m.factors.resize(factors);
+
+        unsigned var = 0;
+        for(unsigned i = 0; i < factors; i++) {
+            var += readVarint();
+            m.factors[i].first = var;
+            m.factors[i].second = readVarint();
+            if(var / 2 >= _names.size())
+                error();
+        }
+    }
+}
+
+void BinaryReader::readFormula(BinaryFormula & f, unsigned depth)
+{
+    if(_s == _end || depth > maxDepth)
+        error();
+
+    f.tag = (binaryTag)*_s++;
+    f.operands.clear();
+    f.system.clear();
+
+    switch(f.tag) {
+    case BIN_TRUE:
+    case BIN_FALSE:
+        return;
+    case BIN_NOT:
+        f.operands.resize(1);
+        readFormula(f.operands[0], depth + 1);
+        return;
+    case BIN_AND:
+    case BIN_OR:
+    case BIN_IMP:
+    case BIN_IFF:
+        f.operands.resize(2);
+        readFormula(f.operands[0], depth + 1);
+        readFormula(f.operands[1], depth + 1);
+        return;
+    case BIN_FORALL:
+    case BIN_EXISTS:
+        f.variable = readVarint();
+        if(f.variable >= _names.size())
+            error();
+        f.operands.resize(1);
+        readFormula(f.operands[0], depth + 1);
+        return;
+    case BIN_SYSTEM:
+    {
+        uint64_t n = readVarint();
+        if(n > (uint64_t)(_end - _s))
+            error();
+        f.system.resize(n);
+        for(BinaryPolynomial & p : f.system)
+            readPolynomial(p);
+        return;
+    }
+    default:
+        error();
+    }
+}
+
+bool BinaryReader::next(BinaryStatement & statement)
+{
+    while(_s != _end) {
+        unsigned char tag = *_s++;
+
+        switch(tag) {
+        case BIN_NAME:
+        {
+            uint64_t id = readVarint();
+            std::string name = readString();
+            if(id >= maxNames)
+                error();
+            if(id >= _names.size())
+                _names.resize(id + 1);
+            _names[id] = name;
+            break;
+        }
+        case BIN_STATEMENT:
+            statement.error = false;
+            statement.message.clear();
+            readFormula(statement.formula, 0);
+            return true;
+        case BIN_ERROR:
+            statement.error = true;
+            statement.message = readString();
+            statement.formula.tag = BIN_FALSE;
+            statement.formula.operands.clear();
+            statement.formula.system.clear();
+            return true;
+        default:
+            error();
+        }
+    }
+
+    return false;
+}
+
+const std::string & BinaryReader::pointName(unsigned point) const
+{
+    if(point >= _names.size())
+        error();
+    return _names[point];
+}
+
+std::string BinaryReader::variableName(unsigned var) const
+{
+    return pointName(var / 2) + (var % 2 == 0 ? "_x" : "_y");
+}
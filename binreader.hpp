@@ -0,0 +1,113 @@
+#ifndef _BINREADER_H
+#define _BINREADER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/* Binarni zapis prevoda (opcija -b) i citac za programe koji dalje
+   obradjuju sisteme polinoma. Citac ne zavisi od ostatka programa:
+   za njega su dovoljni binreader.hpp i binreader.cpp.
+
+   Zapis pocinje sa 4 bajta "AGB1", a zatim slede zapisi do kraja ulaza.
+   Svi brojevi su varint (7 bita po bajtu, najnizi prvi); oznaceni
+   brojevi su pre toga zigzag kodirani.
+
+     BIN_NAME id duzina bajtovi    ime tacke id; pojavljuje se pre prve
+                                   naredbe koja koristi tacku (moze se
+                                   ponoviti, uvek sa istim imenom)
+     BIN_STATEMENT formula         prevod jedne naredbe
+     BIN_ERROR duzina bajtovi      poruka za neispravnu naredbu ili
+                                   naredbu ciji koeficijent ne staje
+                                   u 64 bita
+
+   Formula je zapisana prefiksno:
+
+     BIN_TRUE, BIN_FALSE
+     BIN_NOT f
+     BIN_AND f g, BIN_OR f g, BIN_IMP f g, BIN_IFF f g
+     BIN_FORALL id f, BIN_EXISTS id f     (id je ime promenljive)
+     BIN_SYSTEM n p1 ... pn               sistem p1 = 0 & ... & pn = 0
+
+   Polinom je broj monoma pa monomi; monom je brojilac (zigzag),
+   imenilac, broj cinilaca i cinioci (promenljiva, izlozilac) rastuce
+   po promenljivoj. Prva promenljiva monoma je zapisana direktno, a
+   ostale kao razlika u odnosu na prethodnu. Promenljiva v je
+   koordinata v % 2 (0 = x, 1 = y) tacke v / 2. */
+
+enum binaryTag {
+    BIN_NAME = 1,
+    BIN_STATEMENT = 2,
+    BIN_ERROR = 3,
+
+    BIN_TRUE = 16,
+    BIN_FALSE,
+    BIN_NOT,
+    BIN_AND,
+    BIN_OR,
+    BIN_IMP,
+    BIN_IFF,
+    BIN_FORALL,
+    BIN_EXISTS,
+    BIN_SYSTEM
+};
+
+static const char binaryMagic[4] = { 'A', 'G', 'B', '1' };
+
+struct BinaryMonomial {
+    int64_t num;
+    int64_t den;
+    std::vector<std::pair<unsigned, unsigned> > factors;
+};
+
+typedef std::vector<BinaryMonomial> BinaryPolynomial;
+
+struct BinaryFormula {
+    binaryTag tag;
+
+    /* Podformule (BIN_NOT, binarni veznici i kvantifikatori). */
+    std::vector<BinaryFormula> operands;
+
+    /* Promenljiva kvantifikatora. */
+    unsigned variable;
+
+    /* Jednacine p = 0 za BIN_SYSTEM. */
+    std::vector<BinaryPolynomial> system;
+};
+
+struct BinaryStatement {
+    /* Naredba nije ispravna; poruka je u message. */
+    bool error;
+    std::string message;
+    BinaryFormula formula;
+};
+
+/* Cita zapis iz memorije; ne kopira ulaz. Neispravan zapis baca
+   runtime_error. */
+class BinaryReader {
+public:
+    BinaryReader(const char * data, size_t length);
+
+    /* Cita sledecu naredbu; vraca false na kraju ulaza. */
+    bool next(BinaryStatement & statement);
+
+    /* Ime tacke, odnosno promenljive polinoma (npr. "a_x"). */
+    const std::string & pointName(unsigned point) const;
+    std::string variableName(unsigned var) const;
+
+private:
+    uint64_t readVarint();
+    int64_t readSigned();
+    std::string readString();
+    void readFormula(BinaryFormula & f, unsigned depth);
+    void readPolynomial(BinaryPolynomial & p);
+    void error() const;
+
+    const unsigned char * _s;
+    const unsigned char * _end;
+    std::vector<std::string> _names;
+};
+
+#endif // _BINREADER_H
@@ -0,0 +1,182 @@
+#include "binwriter.hpp"
+
+/* Tacke cija su imena vec zapisana iz ove niti. */
+static thread_local vector<bool> namedPoints;
+
+/* Zapis jedne naredbe. Imena novih tacaka se skupljaju odvojeno, pa
+   se pri ispisu zapisuju pre same naredbe. Koeficijent koji ne staje
+   u 64 bita se ne moze zapisati, pa se umesto takve naredbe zapisuje
+   BIN_ERROR. */
+class BinaryEncoder {
+public:
+    BinaryEncoder(TranslationContext & ctx)
+        :_ctx(ctx),
+          _overflow(false)
+    {}
+
+    void formula(const Formula & f);
+
+    /* Zapisi BIN_NAME za nove tacke, pa BIN_STATEMENT sa formulom. Imena
+       se zapisuju i uz gresku, jer su vec oznacena kao zapisana. */
+    void write(ostream & ostr)
+    {
+        ostr.write(_names.data(), _names.size());
+        if(_overflow) {
+            writeBinaryError("coefficient does not fit in 64 bits", ostr);
+            return;
+        }
+        ostr.put((char)BIN_STATEMENT);
+        ostr.write(_body.data(), _body.size());
+    }
+
+    static void varint(string & out, uint64_t v)
+    {
+        while(v >= 0x80) {
+            out += (char)(v | 0x80);
+            v >>= 7;
+        }
+        out += (char)v;
+    }
+
+    static void zigzag(string & out, int64_t v)
+    {
+        varint(out, ((uint64_t)v << 1) ^ (uint64_t)(v >> 63));
+    }
+
+    static void text(string & out, const string & s)
+    {
+        varint(out, s.size());
+        out += s;
+    }
+
+private:
+    void point(PointId p);
+    void system(const vector<Polynomial> & system);
+
+    TranslationContext & _ctx;
+    string _names;
+    string _body;
+    vector<Polynomial> _system;
+    bool _overflow;
+};
+
+void BinaryEncoder::point(PointId p)
+{
+    if(p < namedPoints.size() && namedPoints[p])
+        return;
+
+    if(p >= namedPoints.size())
+        namedPoints.resize(p + 1, false);
+    namedPoints[p] = true;
+
+    _names += (char)BIN_NAME;
+    varint(_names, p);
+    text(_names, SymbolTable::name(p));
+}
+
+void BinaryEncoder::system(const vector<Polynomial> & system)
+{
+    for(const Polynomial & p : system)
+        for(const auto & t : p.terms())
+            if(!t.second.isSmall()) {
+                _overflow = true;
+                return;
+            }
+
+    _body += (char)BIN_SYSTEM;
+    varint(_body, system.size());
+
+    for(const Polynomial & p : system) {
+        varint(_body, p.size());
+        for(const auto & t : p.terms()) {
+            zigzag(_body, t.second.num());
+            varint(_body, t.second.den());
+
+            const auto & factors = t.first.factors();
+            varint(_body, factors.size());
+
+            Var previous = 0;
+            for(const auto & f : factors) {
+                point(varPoint(f.first));
+                varint(_body, f.first - previous);
+                varint(_body, f.second);
+                previous = f.first;
+            }
+        }
+    }
+}
+
+void BinaryEncoder::formula(const Formula & f)
+{
+    switch(f->getType()){
+    case BaseFormula::T_TRUE:
+        _body += (char)BIN_TRUE;
+        return;
+    case BaseFormula::T_FALSE:
+        _body += (char)BIN_FALSE;
+        return;
+    case BaseFormula::T_NOT:
+        _body += (char)BIN_NOT;
+        formula(((Not *)f)->getOperand());
+        return;
+    case BaseFormula::T_AND:
+    case BaseFormula::T_OR:
+    case BaseFormula::T_IMP:
+    case BaseFormula::T_IFF:
+    {
+        BaseFormula::Type type = f->getType();
+        _body += (char)(type == BaseFormula::T_AND ? BIN_AND :
+                        type == BaseFormula::T_OR ? BIN_OR :
+                        type == BaseFormula::T_IMP ? BIN_IMP : BIN_IFF);
+        formula(((BinaryConjective *)f)->getOperand1());
+        formula(((BinaryConjective *)f)->getOperand2());
+        return;
+    }
+    case BaseFormula::T_FORALL:
+    case BaseFormula::T_EXISTS:
+    {
+        const Quantifier * q = (Quantifier *)f;
+        _body += (char)(f->getType() == BaseFormula::T_FORALL ? BIN_FORALL : BIN_EXISTS);
+        point(q->getVariable());
+        varint(_body, q->getVariable());
+        formula(q->getOperand());
+        return;
+    }
+    case BaseFormula::T_ATOM:
+    {
+        // Disjednakost tacaka je negacija sistema jednakosti.
+        if(dynamic_cast<Disequality *>(f) != nullptr)
+            _body += (char)BIN_NOT;
+
+        _system.clear();
+        if(!((Atom *)f)->toSystem(_ctx, _system))
+            _body += (char)BIN_FALSE;
+        else if(_system.empty())
+            _body += (char)BIN_TRUE;
+        else
+            system(_system);
+        return;
+    }
+    default:
+        throw logic_error("binary output of a coordinate language formula");
+    }
+}
+
+void writeBinaryHeader(ostream & ostr)
+{
+    ostr.write(binaryMagic, sizeof(binaryMagic));
+}
+
+void writeBinaryStatement(const Formula & f, TranslationContext & ctx, ostream & ostr)
+{
+    BinaryEncoder encoder(ctx);
+    encoder.formula(f);
+    encoder.write(ostr);
+}
+
+void writeBinaryError(const string & message, ostream & ostr)
+{
+    string record(1, (char)BIN_ERROR);
+    BinaryEncoder::text(record, message);
+    ostr.write(record.data(), record.size());
+}
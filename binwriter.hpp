@@ -0,0 +1,22 @@
+#ifndef _BINWRITER_H
+#define _BINWRITER_H
+
+#include "binreader.hpp"
+#include "fol.hpp"
+
+/* Pisanje binarnog zapisa prevoda (opcija -b); format je opisan u
+   binreader.hpp. Atomi se zapisuju kao sistemi polinoma u kanonskom
+   obliku, isti kao u opciji -p.
+
+   Ime tacke se zapisuje pre prve naredbe koja je koristi. Svaka nit
+   pamti koja je imena vec zapisala, pa u paketnom i protocnom rezimu
+   isto ime moze biti zapisano vise puta, ali uvek pre upotrebe. */
+
+/* Pocetak zapisa; pise se jednom, pre prve naredbe. */
+void writeBinaryHeader(ostream & ostr);
+
+void writeBinaryStatement(const Formula & f, TranslationContext & ctx, ostream & ostr);
+
+void writeBinaryError(const string & message, ostream & ostr);
+
+#endif // _BINWRITER_H
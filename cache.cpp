@@ -0,0 +1,103 @@
+#include "cache.hpp"
+
+#include <algorithm>
+
+thread_local TranslationCache::Shard TranslationCache::_shard;
+vector<TranslationCache::Shard *> TranslationCache::_shards;
+TranslationCache::Totals TranslationCache::_retired;
+mutex TranslationCache::_mutex;
+
+TranslationCache::Key::Key(relation r, const vector<extendedPoint> & ops, bool normInd)
+    :rel(r),
+      normalForm(normInd),
+      arity(ops.size())
+{
+    for(unsigned i = 0; i < 5; i++) {
+        points[i] = i < arity ? ops[i].point : NO_POINT;
+        levels[i] = i < arity ? ops[i].level : notOptimized;
+    }
+}
+
+bool TranslationCache::Key::operator == (const Key & k) const
+{
+    if(rel != k.rel || normalForm != k.normalForm || arity != k.arity)
+        return false;
+
+    for(unsigned i = 0; i < arity; i++)
+        if(points[i] != k.points[i] || levels[i] != k.levels[i])
+            return false;
+
+    return true;
+}
+
+size_t TranslationCache::KeyHash::operator () (const Key & k) const
+{
+    size_t h = k.rel * 2 + k.normalForm;
+    for(unsigned i = 0; i < k.arity; i++)
+        h = h * 0x100000001b3ULL ^ (k.points[i] * 4 + k.levels[i]);
+    return h;
+}
+
+const string * TranslationCache::find(const Key & key)
+{
+    auto it = _shard.entries.find(key);
+    if(it == _shard.entries.end()) {
+        _shard.misses++;
+        return nullptr;
+    }
+
+    _shard.hits++;
+    return &it->second;
+}
+
+const string & TranslationCache::insert(const Key & key, const string & translation)
+{
+    if(_shard.entries.size() >= capacity)
+        _shard.entries.clear();
+
+    return _shard.entries.emplace(key, translation).first->second;
+}
+
+TranslationCache::Shard::Shard()
+    :hits(0),
+      misses(0)
+{
+    lock_guard<mutex> lock(_mutex);
+    _shards.push_back(this);
+}
+
+TranslationCache::Shard::~Shard()
+{
+    lock_guard<mutex> lock(_mutex);
+    _retired.hits += hits;
+    _retired.misses += misses;
+    _retired.size += entries.size();
+    _shards.erase(std::find(_shards.begin(), _shards.end(), this));
+}
+
+TranslationCache::Totals TranslationCache::totals()
+{
+    lock_guard<mutex> lock(_mutex);
+    Totals t = _retired;
+    for(const Shard * s : _shards) {
+        t.hits += s->hits;
+        t.misses += s->misses;
+        t.size += s->entries.size();
+    }
+    return t;
+}
+
+size_t TranslationCache::hits()
+{
+    return totals().hits;
+}
+
+size_t TranslationCache::misses()
+{
+    return totals().misses;
+}
+
+size_t TranslationCache::size()
+{
+    return totals().size;
+}
@@ -0,0 +1,71 @@
+#ifndef _CACHE_H
+#define _CACHE_H
+
+#include "fol.hpp"
+
+#include <mutex>
+#include <unordered_map>
+
+/* Kes ispisanih prevoda atoma. Kljuc je relacija, identifikatori tacaka
+   i nivo optimizacije svake tacke (i rezim ispisa), pa se isti atom
+   ponovljen u hiljadama naredbi prevodi samo jednom.
+
+   Svaka nit ima svoj deo kesa, pa pretraga ne zahteva zakljucavanje;
+   statistika (hits, misses, size) je zbir po svim nitima i ima smisla
+   tek kada se prevodjenje zavrsi. */
+class TranslationCache {
+public:
+    struct Key {
+        relation rel;
+        bool normalForm;
+        unsigned arity;
+        PointId points[5];
+        optimizationLevel levels[5];
+
+        Key(relation r, const vector<extendedPoint> & ops, bool normInd);
+
+        bool operator == (const Key & k) const;
+    };
+
+    /* Ispisan prevod ili nullptr ako atom nije u kesu. */
+    static const string * find(const Key & key);
+    static const string & insert(const Key & key, const string & translation);
+
+    static size_t hits();
+    static size_t misses();
+    static size_t size();
+
+    /* Najveci broj prevoda; kada se popuni kes se prazni. */
+    static const size_t capacity = 1 << 20;
+
+private:
+    struct KeyHash {
+        size_t operator () (const Key & k) const;
+    };
+
+    /* Deo kesa jedne niti. Pri kraju rada niti njena statistika se
+       dodaje u _retired. */
+    struct Shard {
+        unordered_map<Key, string, KeyHash> entries;
+        size_t hits;
+        size_t misses;
+
+        Shard();
+        ~Shard();
+    };
+
+    struct Totals {
+        size_t hits;
+        size_t misses;
+        size_t size;
+    };
+
+    static Totals totals();
+
+    static thread_local Shard _shard;
+    static vector<Shard *> _shards;
+    static Totals _retired;
+    static mutex _mutex;
+};
+
+#endif // _CACHE_H
@@ -0,0 +1,368 @@
+#include "groebner.hpp"
+#include "modular.hpp"
+
+#include <algorithm>
+#include <map>
+
+/* F4 (Faugere): u svakom koraku se uzimaju svi parovi najmanjeg stepena
+   NZS, i oba mnozioca svakog para postaju vrste retke Makolijeve
+   matrice. Simbolicka priprema dodaje, za svaki monom koji se pojavi a
+   deljiv je vodecim monomom baze, vrstu baze koja ga ponistava. Kolone
+   su monomi u opadajucem uredjenju.
+
+   Eliminacija koristi strukturu matrice: pivot vrste (vrste baze i
+   prve vrste parova) su vec u stepenastom obliku, svaka sa svojom
+   vodecom kolonom, i ne menjaju se. Redukuju se samo ostale vrste,
+   jedna po jedna, preko gustog akumulatora. Redukovana vrsta cija
+   vodeca kolona nema pivot postaje novi pivot i novi polinom baze.
+
+   Sa f4ModularAlgorithm se ista eliminacija radi po prostim brojevima
+   (modular.hpp), nad gustim vrstama, i rezultat se vraca kineskom
+   teoremom o ostacima i racionalnom rekonstrukcijom. Slike po
+   "nesrecnim" prostim brojevima, kod kojih se neki vodeci koeficijent
+   svede na nulu, imaju drugaciji raspored pivota i odbacuju se.
+   Rekonstrukcija se proverava po jos jednom prostom broju; ako ne
+   uspe, matrica se eliminise tacno. */
+
+typedef vector<pair<unsigned, Rational> > SparseRow;
+
+namespace {
+
+struct MonomialGreater {
+    bool operator () (const Monomial & m1, const Monomial & m2) const
+    {
+        return Monomial::compare(m1, m2, Polynomial::order) > 0;
+    }
+};
+
+class MacaulayMatrix {
+public:
+    /* Vrsta para ili vrsta baze iz simbolicke pripreme. Vrsta postaje
+       pivot ako njena vodeca kolona jos nema pivot; inace se redukuje.
+       Tako prva vrsta para najcesce sluzi kao pivot za drugu. */
+    void addRow(const Polynomial & p)
+    {
+        Column & lead = column(p.leadingMonomial());
+        if(lead.pivot)
+            _rows.push_back(p);
+        else {
+            lead.pivot = true;
+            _reducers.push_back(p);
+        }
+
+        for(const auto & t : p.terms())
+            column(t.first);
+    }
+
+    bool hasPivot(const Monomial & m) const
+    {
+        return _columns.at(m).pivot;
+    }
+
+    /* Sledeci monom koji simbolicka priprema jos nije obradila. */
+    bool nextMonomial(Monomial & m)
+    {
+        if(_queue.empty())
+            return false;
+        m = _queue.back();
+        _queue.pop_back();
+        return true;
+    }
+
+    /* Redukuje vrste koje nisu pivoti; vraca nove polinome. */
+    vector<Polynomial> reduce(unsigned & zeroRows);
+
+    /* Isto, po prostim brojevima; false ako rekonstrukcija ne uspe. */
+    bool reduceModular(unsigned & zeroRows, vector<Polynomial> & result);
+
+private:
+    /* Slika eliminacije po jednom prostom broju: za svaku novu vrstu
+       (redni broj vrste, vodeca kolona) i ostaci od vodece kolone. */
+    struct ModularImage {
+        vector<pair<unsigned, unsigned> > pattern;
+        vector<vector<uint32_t> > rows;
+    };
+
+    void index();
+    bool eliminate(const PrimeField & field, ModularImage & image) const;
+
+    struct Column {
+        Column()
+            :index(0),
+              pivot(false)
+        {}
+
+        unsigned index;
+        bool pivot;
+    };
+
+    Column & column(const Monomial & m)
+    {
+        auto inserted = _columns.insert(make_pair(m, Column()));
+        if(inserted.second)
+            _queue.push_back(m);
+        return inserted.first->second;
+    }
+
+    SparseRow sparse(const Polynomial & p) const;
+
+    map<Monomial, Column, MonomialGreater> _columns;
+    vector<Monomial> _queue;
+    vector<Polynomial> _reducers;
+    vector<Polynomial> _rows;
+
+    // Posle index(): monomi kolona i vrste po kolonama.
+    vector<Monomial> _monomials;
+    vector<SparseRow> _pivotRows;
+    vector<SparseRow> _otherRows;
+};
+
+}
+
+SparseRow MacaulayMatrix::sparse(const Polynomial & p) const
+{
+    SparseRow row;
+    row.reserve(p.size());
+    for(const auto & t : p.terms())
+        row.push_back(make_pair(_columns.at(t.first).index, t.second));
+    return row;
+}
+
+void MacaulayMatrix::index()
+{
+    _monomials.reserve(_columns.size());
+    for(auto & c : _columns) {
+        c.second.index = _monomials.size();
+        _monomials.push_back(c.first);
+    }
+
+    for(const Polynomial & p : _reducers)
+        _pivotRows.push_back(sparse(p));
+    for(const Polynomial & p : _rows)
+        _otherRows.push_back(sparse(p));
+}
+
+vector<Polynomial> MacaulayMatrix::reduce(unsigned & zeroRows)
+{
+    if(_monomials.empty())
+        index();
+
+    unsigned columns = _monomials.size();
+    vector<SparseRow> pivots = _pivotRows;
+    vector<int> pivot(columns, -1);
+    for(unsigned k = 0; k < pivots.size(); k++)
+        pivot[pivots[k][0].first] = k;
+
+    vector<Polynomial> result;
+    vector<Rational> dense(columns);
+
+    for(const SparseRow & row : _otherRows) {
+        unsigned first = row[0].first;
+        for(const auto & e : row)
+            dense[e.first] = e.second;
+
+        SparseRow reduced;
+        for(unsigned c = first; c < columns; c++) {
+            if(dense[c].isZero())
+                continue;
+
+            if(pivot[c] < 0) {
+                reduced.push_back(make_pair(c, dense[c]));
+                dense[c] = Rational();
+                continue;
+            }
+
+            // Pivoti su monicni.
+            Rational factor = dense[c];
+            for(const auto & e : pivots[pivot[c]])
+                dense[e.first] -= factor * e.second;
+        }
+
+        if(reduced.empty()) {
+            zeroRows++;
+            continue;
+        }
+
+        Rational inverse = Rational(1) / reduced[0].second;
+        Polynomial::Terms terms;
+        terms.reserve(reduced.size());
+        for(auto & e : reduced) {
+            e.second *= inverse;
+            terms.push_back(Polynomial::Term(_monomials[e.first], e.second));
+        }
+
+        pivot[reduced[0].first] = pivots.size();
+        pivots.push_back(move(reduced));
+        result.push_back(Polynomial(move(terms)));
+    }
+
+    return result;
+}
+
+/* Isti redosled koraka kao reduce, ali su pivoti gusti od vodece
+   kolone, pa je svako oduzimanje jedan poziv subtractMultiple. */
+bool MacaulayMatrix::eliminate(const PrimeField & field, ModularImage & image) const
+{
+    unsigned columns = _monomials.size();
+    vector<vector<uint32_t> > pivots;
+    vector<int> pivot(columns, -1);
+
+    for(const SparseRow & row : _pivotRows) {
+        unsigned lead = row[0].first;
+        vector<uint32_t> dense(columns - lead, 0);
+        for(const auto & e : row)
+            if(!field.fromRational(e.second, dense[e.first - lead]))
+                return false;
+        pivot[lead] = pivots.size();
+        pivots.push_back(move(dense));
+    }
+
+    vector<uint32_t> acc(columns, 0);
+    for(unsigned k = 0; k < _otherRows.size(); k++) {
+        const SparseRow & row = _otherRows[k];
+        for(const auto & e : row)
+            if(!field.fromRational(e.second, acc[e.first]))
+                return false;
+
+        int lead = -1;
+        for(unsigned c = row[0].first; c < columns; c++) {
+            if(acc[c] == 0)
+                continue;
+            if(pivot[c] >= 0)
+                field.subtractMultiple(&acc[c], pivots[pivot[c]].data(), acc[c], columns - c);
+            else if(lead < 0)
+                lead = c;
+        }
+
+        if(lead < 0)
+            continue;
+
+        vector<uint32_t> dense(acc.begin() + lead, acc.end());
+        fill(acc.begin() + lead, acc.end(), 0);
+        field.scale(dense.data(), field.inverse(dense[0]), dense.size());
+
+        image.pattern.push_back(make_pair(k, lead));
+        image.rows.push_back(dense);
+        pivot[lead] = pivots.size();
+        pivots.push_back(move(dense));
+    }
+
+    return true;
+}
+
+bool MacaulayMatrix::reduceModular(unsigned & zeroRows, vector<Polynomial> & result)
+{
+    if(_monomials.empty())
+        index();
+
+    // Cetiri slike za rekonstrukciju i peta za proveru, sve sa istim
+    // rasporedom pivota. Kod nesrecnog prostog broja prva razlika u
+    // rasporedu je kasnija vodeca kolona ili izgubljena vrsta, pa je
+    // leksikografski manji raspored onaj pravi.
+    const unsigned needed = 5;
+    vector<ModularImage> images;
+    vector<uint32_t> primes;
+
+    for(unsigned i = 0; i < PrimeField::primeCount() && images.size() < needed; i++) {
+        PrimeField field(PrimeField::prime(i));
+        ModularImage image;
+        if(!eliminate(field, image))
+            continue;
+
+        if(!images.empty() && image.pattern != images[0].pattern) {
+            if(images[0].pattern < image.pattern)
+                continue;
+            images.clear();
+            primes.clear();
+        }
+
+        images.push_back(move(image));
+        primes.push_back(field.prime());
+    }
+
+    if(images.size() < needed)
+        return false;
+
+    ChineseRemainder crt(vector<uint32_t>(primes.begin(), primes.begin() + 4));
+    PrimeField check(primes[4]);
+
+    vector<Polynomial> added;
+    uint32_t residues[4];
+    for(unsigned r = 0; r < images[0].rows.size(); r++) {
+        unsigned lead = images[0].pattern[r].second;
+        Polynomial::Terms terms;
+
+        for(unsigned o = 0; o < images[0].rows[r].size(); o++) {
+            for(unsigned i = 0; i < 4; i++)
+                residues[i] = images[i].rows[r][o];
+
+            Rational value;
+            uint32_t image;
+            if(!crt.rational(residues, value) || !check.fromRational(value, image) ||
+                    image != images[4].rows[r][o])
+                return false;
+
+            if(!value.isZero())
+                terms.push_back(Polynomial::Term(_monomials[lead + o], value));
+        }
+
+        added.push_back(Polynomial(move(terms)));
+    }
+
+    zeroRows += _otherRows.size() - added.size();
+    result.swap(added);
+    return true;
+}
+
+void GroebnerBasis::f4()
+{
+    while(!_pairs.empty() && !_unit) {
+        unsigned degree = _pairs[0].lcm.degree();
+        for(const Pair & p : _pairs)
+            degree = min(degree, p.lcm.degree());
+
+        MacaulayMatrix matrix;
+        vector<Pair> rest;
+        for(const Pair & p : _pairs) {
+            if(p.lcm.degree() != degree) {
+                rest.push_back(p);
+                continue;
+            }
+
+            const Polynomial & f = _polys[p.i];
+            const Polynomial & g = _polys[p.j];
+            matrix.addRow(f.times(p.lcm / f.leadingMonomial(), 1));
+            matrix.addRow(g.times(p.lcm / g.leadingMonomial(), 1));
+        }
+        _pairs.swap(rest);
+
+        Monomial m;
+        while(matrix.nextMonomial(m)) {
+            if(matrix.hasPivot(m))
+                continue;
+            int k = reducer(m);
+            if(k >= 0)
+                matrix.addRow(_polys[k].times(m / _polys[k].leadingMonomial(), 1));
+        }
+
+        unsigned zeroRows = 0;
+        vector<Polynomial> added;
+        if(_algorithm == f4ModularAlgorithm && matrix.reduceModular(zeroRows, added))
+            _statistics.liftedMatrices++;
+        else
+            added = matrix.reduce(zeroRows);
+        _statistics.zeroReductions += zeroRows;
+        _statistics.matrices++;
+
+        // Vece vodece monome prvo, da bi manji deljivi od njih
+        // iskljucili vece iz aktivnog dela baze.
+        sort(added.begin(), added.end(), [](const Polynomial & p1, const Polynomial & p2) {
+            return Monomial::compare(p1.leadingMonomial(), p2.leadingMonomial(), Polynomial::order) > 0;
+        });
+        for(const Polynomial & h : added) {
+            insert(h);
+            if(_unit)
+                break;
+        }
+    }
+}
@@ -1,202 +1,169 @@
 #include "fol.hpp"
-#include "optimization.h"
+#include "templates.hpp"
+#include "cache.hpp"
+#include "binwriter.hpp"
+#include "smt.hpp"
+#include "prover.hpp"
+
+void BaseFormula::doTheMagic(bool optInd, outputFormat format, ostream& ostr){
+    TranslationContext ctx(optInd, format);
+    if(format == binaryOutput) {
+        writeBinaryStatement(this, ctx, ostr);
+        return;
+    }
+    if(format == smtOutput) {
+        writeSmtStatement(this, ctx, ostr);
+        return;
+    }
+    if(format == proofOutput) {
+        writeProof(this, ctx, ostr);
+        return;
+    }
+    printConvertedFormula(ostr, ctx);
+    ostr << '\n';
+}
 
-void BaseFormula::doTheMagic(bool optInd, ostream& ostr){
-    optimization::optimizedVar = "";
-    optimization::halfOptimizedVar = "";
+void printStatementError(const string & message, outputFormat format, ostream & ostr)
+{
+    if(format == binaryOutput)
+        writeBinaryError(message, ostr);
+    else if(format == smtOutput)
+        writeSmtError(message, ostr);
+    else
+        ostr << message << '\n';
+}
 
-    optimization::optimizationIndicator = optInd;
-    printConvertedFormula(ostr);
-    ostr << endl;
+vector<extendedPoint> Atom::extendedOperands(TranslationContext & ctx)
+{
+    vector<extendedPoint> extendedOps;
+    for (auto it : _ops){
+        // Argument relacije je konstanta ili slobodna promenljiva; obe su tacke.
+        if(it->getType() == BaseTerm::TT_VARIABLE)
+            extendedOps.push_back(extend(((VariableTerm*)(it))->getVariable(), ctx));
+        else
+            extendedOps.push_back(extend(((FunctionTerm*)(it))->getPoint(), ctx));
+    }
+    return extendedOps;
 }
 
-void Atom::printConvertedFormula(ostream & ostr)
+void Atom::printConvertedFormula(ostream & ostr, TranslationContext & ctx)
 {
-    vector<extendedString> extendedOps;
-    for (auto it : _ops)
-           extendedOps.push_back(extend(((FunctionTerm*)(it.get()))->getSymbol()));
+    vector<extendedPoint> extendedOps = extendedOperands(ctx);
+    toCoordinateLanguage(_rel, extendedOps, ostr, ctx);
+}
 
-    toCoordinateLanguage(getRelation(_p), extendedOps);
+bool Atom::toSystem(TranslationContext & ctx, vector<Polynomial> & system)
+{
+    return RelationTemplate::get(_rel).instantiate(extendedOperands(ctx), system);
 }
 
-extendedString Atom::extend(string varName) {
-    if(optimization::optimizationIndicator && optimization::optimizedVar.size() == 0){
-        optimization::optimizedVar = varName;
-    }
+Formula Atom::coordinateFormula(TranslationContext & ctx)
+{
+    return RelationTemplate::get(_rel).instantiate(extendedOperands(ctx));
+}
+
+extendedPoint Atom::extend(PointId point, TranslationContext & ctx) {
+    return extendedPoint(point, ctx.opt.level(point));
+}
+
+Formula extendedPoint::coord(axis a) const {
+    if(isZero(a))
+        return createConst(0);
+    else
+        return createCoordinate(point, a);
+}
 
-    if(optimization::optimizationIndicator && optimization::optimizedVar.size() > 0 &&
-            varName != optimization::optimizedVar && optimization::halfOptimizedVar.size() == 0){
-        optimization::halfOptimizedVar = varName;
+Formula createNegation(const Formula & f)
+{
+    switch(f->getType()){
+    case BaseFormula::T_CONST:
+        return createConst(-constValue(f));
+    case BaseFormula::T_LIT:
+        return createCoordinate(((Lit *)f)->getPoint(), ((Lit *)f)->getAxis(),
+                                !((Lit *)f)->isNegated());
+    case BaseFormula::T_MINUS:
+        // -(x - y) = (y - x)
+        return createMinus(((Minus *)f)->getOperand2(), ((Minus *)f)->getOperand1());
+    case BaseFormula::T_TIMES:
+        if(isConst(((Times *)f)->getOperand1()))
+            return createTimes(createNegation(((Times *)f)->getOperand1()),
+                               ((Times *)f)->getOperand2());
+        break;
+    default:
+        break;
     }
 
-    optimizationLevel level = notOptimized;
-    if(varName == optimization::optimizedVar){
-        level = optimized;
+    return createMinus(createConst(0), f);
+}
+
+Polynomial toPolynomial(const Formula & f)
+{
+    switch(f->getType()){
+    case BaseFormula::T_LIT:
+    {
+        Polynomial v = Polynomial::variable(coordinateVar(((Lit *)f)->getPoint(),
+                                                          ((Lit *)f)->getAxis()));
+        return ((Lit *)f)->isNegated() ? -v : v;
     }
-    else if (varName == optimization::halfOptimizedVar){
-        level = halfOptimized;
+    case BaseFormula::T_CONST:
+        return Polynomial(constValue(f));
+    case BaseFormula::T_PLUS:
+        return toPolynomial(((Plus *)f)->getOperand1()) + toPolynomial(((Plus *)f)->getOperand2());
+    case BaseFormula::T_MINUS:
+        return toPolynomial(((Minus *)f)->getOperand1()) - toPolynomial(((Minus *)f)->getOperand2());
+    case BaseFormula::T_TIMES:
+        return toPolynomial(((Times *)f)->getOperand1()) * toPolynomial(((Times *)f)->getOperand2());
+    case BaseFormula::T_POW:
+    {
+        Polynomial p = toPolynomial(((Pow *)f)->getOperand());
+        return p * p;
+    }
+    default:
+        return Polynomial();
     }
-
-    return extendedString(varName, level);
 }
 
-const string extendedString::str(axis a){
+/* Ispisuje prevod jednog atoma: stablo izraza, ili (opcija -p) sistem
+   jednacina u kanonskom obliku p = 0. */
+static void translate(relation rel, const vector<extendedPoint>& points,
+                      ostream & ostr, TranslationContext & ctx){
 
-    switch(level){
-    case notOptimized:
-        return varName + apendAxis(a);
-    case optimized:
-        return "0";
-    case halfOptimized:
-        if(a == X)
-            return "0";
-        else
-            return varName + apendAxis(a);
+    const RelationTemplate & t = RelationTemplate::get(rel);
+
+    if(ctx.format != normalFormOutput) {
+        t.instantiate(points)->printConvertedFormula(ostr, ctx);
+        return;
     }
 
-    return "";
-}
+    vector<Polynomial> system;
+    if(!t.instantiate(points, system)) {
+        ostr << "false";
+        return;
+    }
+
+    if(system.empty()) {
+        ostr << "true";
+        return;
+    }
 
-Formula createMinus(const string str1, const string str2) {
-    
-    PredicateSymbol p1 = str1;
-    PredicateSymbol p2 = str2;
-    Formula lit1 = make_shared<Lit>(p1);
-    Formula lit2 = make_shared<Lit>(p2);
-    Formula minus = make_shared<Minus>(lit1, lit2);
-    return minus;
+    for(unsigned i = 0; i < system.size(); i++) {
+        if(i > 0)
+            ostr << " & ";
+        ostr << system[i] << " = 0";
+    }
 }
-static void toCoordinateLanguage(relation rel, vector<extendedString>& points){
-
-    Formula minus1, minus2, minus3, minus4, minus5, minus6, minus7, minus8;
-    Formula times1, times2, times3, times4;
-    Formula pow1, pow2, pow3, pow4;
-    Formula plus1, plus2;
-    Formula equal, equal1, equal2;
-    Formula f1;
-    Formula and1;
-
-    switch(rel){
-        case collinear:
-        {
-        // "<<(0_x - 1_x) * (1_y - 2_y) = (0_y - 1_y) * (1_x - 2_x)>>"
-        minus1 = createMinus(points[0].str(X), points[1].str(X));
-        minus2 = createMinus(points[1].str(Y), points[2].str(Y));
-        minus3 = createMinus(points[0].str(Y), points[1].str(Y));
-        minus4 = createMinus(points[1].str(X), points[2].str(X));
-        
-        times1 = make_shared<Times>(minus1, minus2); 
-        times2 = make_shared<Times>(minus3, minus4);
-        equal = make_shared<Equal>(times1, times2);
-        f1 = ((Equal *)equal.get())->simple();
-        f1->printConvertedFormula(cout); 
-        }
-        break;
-        case parallel:
-        {
-        // "<<(0_x - 1_x) * (2_y - 3_y) = (0_y - 1_y) * (2_x - 3_x)>>"
-        minus1 = createMinus(points[0].str(X), points[1].str(X));
-        minus2 = createMinus(points[2].str(Y), points[3].str(Y));
-        minus3 = createMinus(points[0].str(Y), points[1].str(Y));
-        minus4 = createMinus(points[2].str(X), points[3].str(X));
-        
-        times1 = make_shared<Times>(minus1, minus2); 
-        times2 = make_shared<Times>(minus3, minus4);
-        equal = make_shared<Equal>(times1, times2);
-        f1 = ((Equal *)equal.get())->simple();
-        f1->printConvertedFormula(cout); 
-        }
-        break;
-    case perpendicular:
-        {
-        // "<<(0_x - 1_x) * (2_x - 3_x) + (0_y - 1_y) * (2_y - 3_y) = 0>>"
-        minus1 = createMinus(points[0].str(X), points[1].str(X));
-        minus2 = createMinus(points[2].str(X), points[3].str(X));
-        minus3 = createMinus(points[0].str(Y), points[1].str(Y));
-        minus4 = createMinus(points[2].str(Y), points[3].str(Y));
-        
-        times1 = make_shared<Times>(minus1, minus2); 
-        times2 = make_shared<Times>(minus3, minus4);
-        plus1 = make_shared<Plus>(times1, times2);
-        equal = make_shared<Equal>(plus1, make_shared<Lit>("0"));
-        f1 = ((Equal *)equal.get())->simple();
-        f1->printConvertedFormula(cout); 
-        }   
-        break;
-      
-    case lengths_eq:
-        {
-        // "<<(0_x - 1_x)^2 + (0_y - 1_y)^2 = (2_x - 3_x)^2 + (2_y - 3_y)^2>>"
-        minus1 = createMinus(points[0].str(X), points[1].str(X));
-        minus2 = createMinus(points[0].str(Y), points[1].str(Y));
-        minus3 = createMinus(points[2].str(X), points[3].str(X));
-        minus4 = createMinus(points[2].str(Y), points[3].str(Y));
-
-        pow1 = make_shared<Pow>(minus1);
-        pow2 = make_shared<Pow>(minus2);
-        pow3 = make_shared<Pow>(minus3);
-        pow4 = make_shared<Pow>(minus4);
-
-        plus1 = make_shared<Plus>(pow1, pow2);
-        plus2 = make_shared<Plus>(pow3, pow4);
-
-        equal = make_shared<Equal>(plus1, plus2);
-        f1 = ((Equal *)equal.get())->simple();
-        f1->printConvertedFormula(cout); 
-        }
-        break;    
-    case is_midpoint:
-        {
-        // "<<2 * 0_x = 1_x + 2_x & 2 * 0_y = 1_y + 2_y>>"
-        times1 = make_shared<Times>(make_shared<Lit>("2"), make_shared<Lit>(points[0].str(X)));
-        plus1 = make_shared<Plus>(make_shared<Lit>(points[1].str(X)), make_shared<Lit>(points[2].str(X)));
-        equal1 = make_shared<Equal>(times1, plus1);
-
-        times2 = make_shared<Times>(make_shared<Lit>("2"), make_shared<Lit>(points[0].str(Y)));
-        plus2 = make_shared<Plus>(make_shared<Lit>(points[1].str(Y)), make_shared<Lit>(points[2].str(Y)));
-        equal2 = make_shared<Equal>(times2, plus2);
-
-        and1 = make_shared<And>(equal1, equal2);
-        f1 = ((And *)and1.get())->simple();
-        f1->printConvertedFormula(cout);
-        }
-        break;
-    case is_intersection:
-        {
-        // "<<(0_x - 1_x) * (1_y - 2_y) = (0_y - 1_y) * (1_x - 2_x) & (0_x - 3_x) * (3_y - 4_y) = (0_y - 3_y) * (3_x - 4_x)>>"
-        minus1 = createMinus(points[0].str(X), points[1].str(X));
-        minus2 = createMinus(points[1].str(Y), points[2].str(Y));
-        minus3 = createMinus(points[0].str(Y), points[1].str(Y));
-        minus4 = createMinus(points[1].str(X), points[2].str(X));
-        times1 = make_shared<Times>(minus1, minus2);
-        times2 = make_shared<Times>(minus3, minus4);
-        equal1 = make_shared<Equal>(times1, times2);
-
-        minus5 = createMinus(points[0].str(X), points[3].str(X));
-        minus6 = createMinus(points[3].str(Y), points[4].str(Y));
-        minus7 = createMinus(points[0].str(Y), points[3].str(Y));
-        minus8 = createMinus(points[3].str(X), points[4].str(X));
-        times3 = make_shared<Times>(minus5, minus6);
-        times4 = make_shared<Times>(minus7, minus8);
-        equal2 = make_shared<Equal>(times3, times4);
-
-        and1 = make_shared<And>(equal1, equal2);
-        f1 = ((And *)and1.get())->simple();
-        f1->printConvertedFormula(cout);
-        }
-        break;
-    case is_equal:
-        {
-        // "<<(0_x = 1_x) & (0_y = 1_y)>>"
-        equal1 = make_shared<Equal>(make_shared<Lit>(points[0].str(X)), make_shared<Lit>(points[1].str(X)));
-        equal2 = make_shared<Equal>(make_shared<Lit>(points[0].str(Y)), make_shared<Lit>(points[1].str(Y)));
-
-        and1 = make_shared<And>(equal1, equal2);
-        f1 = ((And *)and1.get())->simple();
-        f1->printConvertedFormula(cout);
-        }
-        break;
-    default:
-        break;
+
+static void toCoordinateLanguage(relation rel, vector<extendedPoint>& points,
+                                 ostream & ostr, TranslationContext & ctx){
+
+    TranslationCache::Key key(rel, points, ctx.format == normalFormOutput);
+
+    const string * translation = TranslationCache::find(key);
+    if(translation == nullptr) {
+        ostringstream translated;
+        translate(rel, points, translated, ctx);
+        translation = &TranslationCache::insert(key, translated.str());
     }
-}
\ No newline at end of file
+
+    ostr << *translation;
+}
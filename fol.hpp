@@ -11,45 +11,39 @@
 #include <algorithm>
 #include <exception>
 
+#include "arena.hpp"
+#include "optimization.h"
+#include "symbols.hpp"
+#include "rational.hpp"
+#include "polynomial.hpp"
+
 #define MAX 100
 
 using namespace std;
 
-typedef string FunctionSymbol;
-typedef string PredicateSymbol;
-typedef string Variable;
-
-enum axis{
-    X,
-    Y
-};
-
-
-static string apendAxis(axis a){
-    if(a == X)
-        return "_x";
-    else
-        return "_y";
-}
-
-enum optimizationLevel{
-    notOptimized = 0,
-    halfOptimized = 1,
-    optimized = 2
-};
+class BaseFormula;
+typedef BaseFormula * Formula;
 
-class extendedString {
+class extendedPoint {
 public:    
-    extendedString(){}
+    extendedPoint(){}
 
-    extendedString(string _varName, optimizationLevel l = notOptimized)
-        :varName(_varName), level(l)
+    extendedPoint(PointId _point, optimizationLevel l = notOptimized)
+        :point(_point), level(l)
     {}
 
-    string varName;
+    PointId point;
     optimizationLevel level;
 
-    const string str(axis a);
+    /* Da li je koordinata po osi a optimizacijom fiksirana na 0. */
+    bool isZero(axis a) const
+    {
+        return level == optimized || (level == halfOptimized && a == X);
+    }
+
+    /* Koordinata tacke po osi a, ili 0 ako je ta koordinata
+       optimizacijom fiksirana. */
+    Formula coord(axis a) const;
 };
 
 enum relation {
@@ -62,41 +56,45 @@ enum relation {
     is_equal
 };
 
-static relation getRelation(string s) {
-    relation par = parallel;
-    if(s == "collinear") {
-        return collinear;
-    }
-    else if(s == "parallel") {
-        return par;
-    }
-    else if(s == "perpendicular") {
-        return perpendicular;
-    }
-    else if(s == "lengths_eq") {
-        return lengths_eq;
-    }
-    else if(s == "is_midpoint") {
-        return is_midpoint;
-    }
-    else if(s == "is_intersection") {
-        return is_intersection;
-    }
-    else {//if(s == "is_equal") 
-        return is_equal;
-    }
-}
-
 static string openExp = "<<";
 static string closeExp = ">>";
 
-static void toCoordinateLanguage(relation rel, vector<extendedString>& points);
+/* Oblik ispisa prevoda. */
+enum outputFormat {
+    infixOutput,        // stablo izraza koordinatnog jezika
+    normalFormOutput,   // jednacine u kanonskom obliku p = 0 (opcija -p)
+    binaryOutput,       // binarni zapis sistema polinoma (opcija -b, vidi binwriter.hpp)
+    smtOutput,          // SMT-LIB2 skript (opcija --smt, vidi smt.hpp)
+    proofOutput         // rezultat dokazivaca (opcija --prove, vidi prover.hpp)
+};
+
+/* Stanje prevoda jedne naredbe. Pravi ga doTheMagic i prosledjuje
+   kroz printConvertedFormula, pa istovremeni prevodi na razlicitim
+   nitima nemaju zajednicko stanje. */
+class TranslationContext {
+public:
+    TranslationContext(bool optInd = false, outputFormat f = infixOutput)
+        :opt(optInd),
+          format(f)
+    {}
+
+    optimization opt;
+    outputFormat format;
+};
+
+static void toCoordinateLanguage(relation rel, vector<extendedPoint>& points,
+                                 ostream & ostr, TranslationContext & ctx);
 
+/* Ispisuje poruku o neispravnoj naredbi u zadatom obliku ispisa. */
+void printStatementError(const string & message, outputFormat format, ostream & ostr);
+
+/* Termovi i formule se prave u areni tekuce naredbe (vidi arena.hpp)
+   i oslobadjaju se svi zajedno kada se naredba obradi. */
 class BaseTerm;
-typedef shared_ptr<BaseTerm> Term;
+typedef BaseTerm * Term;
 
 
-class BaseTerm : public enable_shared_from_this<BaseTerm> {
+class BaseTerm {
 
 public:
     enum Type { TT_VARIABLE, TT_FUNCTION };
@@ -105,11 +103,13 @@ public:
     virtual ~BaseTerm() {}
 };
 
+/* Imena promenljivih i simbola su identifikatori iz tabele simbola
+   koje dodeljuje vec skener (lexer.lpp). */
 class VariableTerm : public BaseTerm {
 private:
-    Variable _v;
+    PointId _v;
 public:
-    VariableTerm(const Variable & v)
+    VariableTerm(PointId v)
         :_v(v)
     {}
 
@@ -118,23 +118,26 @@ public:
         return TT_VARIABLE;
     }
 
-    const Variable & getVariable() const
+    PointId getVariable() const
     {
         return _v;
     }
     virtual void printTerm(ostream & ostr) const
     {
-        ostr << _v;
+        ostr << SymbolTable::name(_v);
     }
 };
 
 class FunctionTerm : public BaseTerm {
 private:
-    FunctionSymbol _f;
+    PointId _f;
     vector<Term> _ops;
 
 public:
-    FunctionTerm(const FunctionSymbol & f,
+    /* Konstante (simboli bez argumenata) su tacke; identifikator
+       simbola je tada i identifikator tacke. Parser ne prihvata
+       slozene termove kao argumente relacija (vidi parser.ypp). */
+    FunctionTerm(PointId f,
                  const vector<Term> & ops = vector<Term> ())
         :_f(f),
           _ops(ops)
@@ -145,7 +148,12 @@ public:
         return TT_FUNCTION;
     }
 
-    const FunctionSymbol & getSymbol() const
+    PointId getSymbol() const
+    {
+        return _f;
+    }
+
+    PointId getPoint() const
     {
         return _f;
     }
@@ -157,7 +165,7 @@ public:
 
     virtual void printTerm(ostream & ostr) const
     {
-        ostr << _f;
+        ostr << SymbolTable::name(_f);
 
         for(unsigned i = 0; i < _ops.size(); i++)
         {
@@ -172,19 +180,35 @@ public:
     }
 };
 
-class BaseFormula;
-typedef shared_ptr<BaseFormula> Formula;
+/* Cvorovi koordinatnog jezika se prave iskljucivo preko ovih funkcija
+   (vidi nodefactory.hpp), tako da su strukturno jednaka podstabla
+   jedan isti objekat i jednakost se svodi na poredjenje pokazivaca. */
+Formula createConst(const Rational & value);
+Formula createCoordinate(PointId point, axis a, bool negated = false);
+Formula createPlus(const Formula & op1, const Formula & op2);
+Formula createMinus(const Formula & op1, const Formula & op2);
+Formula createTimes(const Formula & op1, const Formula & op2);
+Formula createPow(const Formula & op);
+Formula createEqual(const Formula & op1, const Formula & op2);
+Formula createAnd(const Formula & op1, const Formula & op2);
+
+/* -f, uproscen koliko je moguce bez pravljenja (0 - f). */
+Formula createNegation(const Formula & f);
 
-class BaseFormula : public enable_shared_from_this<BaseFormula> {
+/* Razvija aritmeticki izraz (Lit, Const, Plus, Minus, Times, Pow)
+   u polinom. */
+Polynomial toPolynomial(const Formula & f);
+
+class BaseFormula {
 
 public:
 
     enum Type { T_TRUE, T_FALSE, T_ATOM, T_NOT,
-                T_AND, T_OR, T_IMP, T_IFF, T_FORALL, T_EXISTS, T_PLUS, T_MINUS, T_EQ, T_TIMES, T_POW, T_LIT };
+                T_AND, T_OR, T_IMP, T_IFF, T_FORALL, T_EXISTS, T_PLUS, T_MINUS, T_EQ, T_TIMES, T_POW, T_LIT, T_CONST };
 
-    void doTheMagic(bool optInd, ostream& ostr);
+    void doTheMagic(bool optInd, outputFormat format, ostream& ostr);
 
-    virtual void printConvertedFormula(ostream & ostr) = 0;
+    virtual void printConvertedFormula(ostream & ostr, TranslationContext & ctx) = 0;
     virtual Type getType() const = 0;
     //virtual ~BaseFormula() {}
     virtual Formula simple() = 0;
@@ -205,7 +229,7 @@ public:
 class True : public LogicConstant {
 
 public:
-    virtual void printConvertedFormula(ostream & ostr)
+    virtual void printConvertedFormula(ostream & ostr, TranslationContext &)
     {
         ostr << "true";
     }
@@ -216,7 +240,7 @@ public:
     }
 
     virtual Formula simple(){
-        return shared_from_this();
+        return this;
     }
 };
 
@@ -224,7 +248,7 @@ public:
 class False : public LogicConstant {
 
 public:
-    virtual void printConvertedFormula(ostream & ostr)
+    virtual void printConvertedFormula(ostream & ostr, TranslationContext &)
     {
         ostr << "false";
     }
@@ -235,27 +259,44 @@ public:
     }
 
     Formula simple(){
-        return shared_from_this();
+        return this;
     }
 };
 
 class Lit : public BaseFormula {
 protected:
-    PredicateSymbol _p;
+    /* Koordinata tacke _point po osi _axis, eventualno negirana. */
+    PointId _point;
+    axis _axis;
+    bool _negated;
 
 public:
-    Lit(const PredicateSymbol & p)
-        :_p(p)
+    Lit(PointId point, axis a, bool negated = false)
+        :_point(point),
+          _axis(a),
+          _negated(negated)
     {}
 
-    const PredicateSymbol & getSymbol() const
+    PointId getPoint() const
+    {
+        return _point;
+    }
+
+    axis getAxis() const
+    {
+        return _axis;
+    }
+
+    bool isNegated() const
     {
-        return _p;
+        return _negated;
     }
 
-    void printConvertedFormula(ostream & ostr)
+    void printConvertedFormula(ostream & ostr, TranslationContext &)
     {
-        ostr << _p;
+        if(_negated)
+            ostr << "-";
+        ostr << SymbolTable::name(_point) << apendAxis(_axis);
     }
 
     Type getType() const
@@ -264,26 +305,77 @@ public:
     }
 
     virtual Formula simple(){
-        return shared_from_this();
+        return this;
+    }
+};
+
+class Const : public BaseFormula {
+protected:
+    Rational _value;
+
+public:
+    Const(const Rational & value)
+        :_value(value)
+    {}
+
+    const Rational & getValue() const
+    {
+        return _value;
+    }
+
+    void printConvertedFormula(ostream & ostr, TranslationContext &)
+    {
+        ostr << _value;
+    }
+
+    Type getType() const
+    {
+        return T_CONST;
+    }
+
+    virtual Formula simple(){
+        return this;
     }
 };
 
+static inline bool isConst(const Formula & f)
+{
+    return f->getType() == BaseFormula::T_CONST;
+}
+
+static inline bool isConst(const Formula & f, const Rational & value)
+{
+    return f->getType() == BaseFormula::T_CONST && ((Const *)f)->getValue() == value;
+}
+
+static inline const Rational & constValue(const Formula & f)
+{
+    return ((Const *)f)->getValue();
+}
+
+/* Da li je f negirana koordinata ili negativna konstanta. */
+static inline bool isNegative(const Formula & f)
+{
+    return (f->getType() == BaseFormula::T_LIT && ((Lit *)f)->isNegated()) ||
+            (isConst(f) && constValue(f).isNegative());
+}
+
 
 class Atom : public AtomicFormula {
 protected:
-    PredicateSymbol _p;
+    relation _rel;
     vector<Term> _ops;
 
 public:
-    Atom(const PredicateSymbol & p,
+    Atom(relation rel,
          const vector<Term> & ops = vector<Term>())
-        :_p(p),
+        :_rel(rel),
           _ops(ops)
     {}
 
-    const PredicateSymbol & getSymbol() const
+    relation getRelation() const
     {
-        return _p;
+        return _rel;
     }
 
     const vector<Term> & getOperands() const
@@ -291,7 +383,14 @@ public:
         return _ops;
     }
 
-    virtual void printConvertedFormula(ostream & ostr);
+    virtual void printConvertedFormula(ostream & ostr, TranslationContext & ctx);
+
+    /* Dodaje sistem jednacina p = 0 atoma u kanonskom obliku (kao u -p);
+       vraca false ako je sistem protivrecan. */
+    bool toSystem(TranslationContext & ctx, vector<Polynomial> & system);
+
+    /* Uprosceno stablo prevoda atoma (kao u ispisu bez -p). */
+    Formula coordinateFormula(TranslationContext & ctx);
 
     virtual Type getType() const
     {
@@ -299,7 +398,7 @@ public:
     }
 
     virtual Formula simple(){
-        return shared_from_this();
+        return this;
     }
 
 private :
@@ -312,13 +411,14 @@ private :
         return str;
     }
 
-    extendedString extend(string varName);
+    extendedPoint extend(PointId point, TranslationContext & ctx);
+    vector<extendedPoint> extendedOperands(TranslationContext & ctx);
 };
 
 class Equality : public Atom {
 public:
     Equality(const Term & lop, const Term & rop)
-        :Atom("=", vector<Term> ())
+        :Atom(is_equal, vector<Term> ())
     {
         _ops.push_back(lop);
         _ops.push_back(rop);
@@ -334,7 +434,7 @@ public:
         return _ops[1];
     }
 
-    virtual void printConvertedFormula(ostream & ostr)
+    virtual void printConvertedFormula(ostream & ostr, TranslationContext &)
     {
         _ops[0]->printTerm(ostr);
         ostr << " = ";
@@ -347,7 +447,7 @@ public:
 class Disequality : public Atom {
 public:
     Disequality(const Term & lop, const Term & rop)
-        :Atom("~=", vector<Term> ())
+        :Atom(is_equal, vector<Term> ())
     {
         _ops.push_back(lop);
         _ops.push_back(rop);
@@ -363,7 +463,7 @@ public:
         return _ops[1];
     }
 
-    virtual void printConvertedFormula(ostream & ostr)
+    virtual void printConvertedFormula(ostream & ostr, TranslationContext &)
     {
 
         _ops[0]->printTerm(ostr);
@@ -393,7 +493,7 @@ public:
         :UnaryConjective(op)
     {}
 
-    virtual void printConvertedFormula(ostream & ostr)
+    virtual void printConvertedFormula(ostream & ostr, TranslationContext & ctx)
     {
         ostr << "~";
         Type op_type = _op->getType();
@@ -402,7 +502,7 @@ public:
                 op_type == T_IMP || op_type == T_IFF)
             ostr << "(";
 
-        _op->printConvertedFormula(ostr);
+        _op->printConvertedFormula(ostr, ctx);
 
         if(op_type == T_AND || op_type == T_OR ||
                 op_type == T_IMP || op_type == T_IFF)
@@ -423,11 +523,11 @@ public:
         Formula simp_op = _op->simple();
   
         if(simp_op->getType() == T_TRUE)
-            return make_shared<False>();
+            return makeNode<False>();
         else if(simp_op->getType() == T_FALSE)
-            return make_shared<True>();
+            return makeNode<True>();
         else
-            return make_shared<Not>(simp_op);
+            return makeNode<Not>(simp_op);
     }
 };
 
@@ -459,7 +559,7 @@ public:
         :BinaryConjective(op1, op2)
     {}
 
-    virtual void printConvertedFormula(ostream & ostr)
+    virtual void printConvertedFormula(ostream & ostr, TranslationContext & ctx)
     {
         Type op1_type = _op1->getType();
         Type op2_type = _op2->getType();
@@ -468,7 +568,7 @@ public:
                 op1_type == T_IFF)
             ostr << "(";
 
-        _op1->printConvertedFormula(ostr);
+        _op1->printConvertedFormula(ostr, ctx);
 
         if(op1_type == T_OR || op1_type == T_IMP ||
                 op1_type == T_IFF)
@@ -480,7 +580,7 @@ public:
                 op2_type == T_IFF || op2_type == T_AND)
             ostr << "(";
 
-        _op2->printConvertedFormula(ostr);
+        _op2->printConvertedFormula(ostr, ctx);
 
         if(op2_type == T_OR || op2_type == T_IMP ||
                 op2_type == T_IFF || op2_type == T_AND)
@@ -505,9 +605,9 @@ public:
             return simp_op1;
         else if(simp_op1->getType() == T_FALSE ||
                 simp_op2->getType() == T_FALSE)
-            return make_shared<False>();
+            return makeNode<False>();
         else
-        return make_shared<And>(simp_op1, simp_op2);
+        return createAnd(simp_op1, simp_op2);
     }
 };
 
@@ -517,7 +617,7 @@ public:
         :BinaryConjective(op1, op2)
     {}
 
-    virtual void printConvertedFormula(ostream & ostr)
+    virtual void printConvertedFormula(ostream & ostr, TranslationContext & ctx)
     {
 
         Type op1_type = _op1->getType();
@@ -526,7 +626,7 @@ public:
         if(op1_type == T_IMP || op1_type == T_IFF)
             ostr << "(";
 
-        _op1->printConvertedFormula(ostr);
+        _op1->printConvertedFormula(ostr, ctx);
 
         if(op1_type == T_IMP || op1_type == T_IFF)
             ostr << ")";
@@ -537,7 +637,7 @@ public:
                 op2_type == T_IFF || op2_type == T_OR)
             ostr << "(";
 
-        _op2->printConvertedFormula(ostr);
+        _op2->printConvertedFormula(ostr, ctx);
 
         if(op2_type == T_IMP ||
                 op2_type == T_IFF || op2_type == T_OR)
@@ -562,9 +662,9 @@ public:
             return simp_op1;
         else if(simp_op1->getType() == T_TRUE ||
                 simp_op2->getType() == T_TRUE)
-        return make_shared<True>();
+        return makeNode<True>();
         else
-        return make_shared<Or>(simp_op1, simp_op2);
+        return makeNode<Or>(simp_op1, simp_op2);
     }
 };
 
@@ -574,7 +674,7 @@ public:
         :BinaryConjective(op1, op2)
     {}
 
-    virtual void printConvertedFormula(ostream & ostr)
+    virtual void printConvertedFormula(ostream & ostr, TranslationContext & ctx)
     {
 
         Type op1_type = _op1->getType();
@@ -583,7 +683,7 @@ public:
         if(op1_type == T_IFF)
             ostr << "(";
 
-        _op1->printConvertedFormula(ostr);
+        _op1->printConvertedFormula(ostr, ctx);
 
         if(op1_type == T_IFF)
             ostr << ")";
@@ -593,7 +693,7 @@ public:
         if(op2_type == T_IMP || op2_type == T_IFF)
             ostr << "(";
 
-        _op2->printConvertedFormula(ostr);
+        _op2->printConvertedFormula(ostr, ctx);
 
         if(op2_type == T_IMP || op2_type == T_IFF)
             ostr << ")";
@@ -615,13 +715,13 @@ public:
         if(simp_op1->getType() == T_TRUE)
             return simp_op2;
         else if(simp_op2->getType() == T_TRUE)
-            return make_shared<True>();
+            return makeNode<True>();
         else if(simp_op1->getType() == T_FALSE) 
-            return make_shared<True>();
+            return makeNode<True>();
         else if(simp_op2->getType() == T_FALSE)
-            return make_shared<Not>(simp_op1);
+            return makeNode<Not>(simp_op1);
         else
-            return make_shared<Imp>(simp_op1, simp_op2);
+            return makeNode<Imp>(simp_op1, simp_op2);
     }
 };
 
@@ -632,20 +732,20 @@ public:
         :BinaryConjective(op1, op2)
     {}
 
-    virtual void printConvertedFormula(ostream & ostr)
+    virtual void printConvertedFormula(ostream & ostr, TranslationContext & ctx)
     {
 
         Type op1_type = _op1->getType();
         Type op2_type = _op2->getType();
 
-        _op1->printConvertedFormula(ostr);
+        _op1->printConvertedFormula(ostr, ctx);
 
         ostr << " => ";
 
         if(op1_type == T_IFF)
             ostr << "(";
 
-        _op2->printConvertedFormula(ostr);
+        _op2->printConvertedFormula(ostr, ctx);
 
         if(op2_type == T_IFF)
             ostr << ")";
@@ -667,32 +767,32 @@ public:
       
         if( simp_op1->getType() == T_FALSE && 
             simp_op2->getType() == T_FALSE)
-            return make_shared<True>();
+            return makeNode<True>();
         else if(simp_op1->getType() == T_TRUE)
             return simp_op2;
         else if(simp_op2->getType() == T_TRUE)
             return simp_op1;
         else if(simp_op1->getType() == T_FALSE) 
-            return make_shared<Not>(simp_op2);
+            return makeNode<Not>(simp_op2);
         else if(simp_op2->getType() == T_FALSE)
-            return make_shared<Not>(simp_op1);
+            return makeNode<Not>(simp_op1);
         else
-            return make_shared<Iff>(simp_op1, simp_op2);
+            return makeNode<Iff>(simp_op1, simp_op2);
     }
 };
 
 
 class Quantifier : public BaseFormula {
 protected:
-    Variable _v;
+    PointId _v;
     Formula  _op;
 public:
-    Quantifier(const Variable & v, const Formula & op)
+    Quantifier(PointId v, const Formula & op)
         :_v(v),
           _op(op)
     {}
 
-    const Variable & getVariable() const
+    PointId getVariable() const
     {
         return _v;
     }
@@ -703,14 +803,14 @@ public:
     }
 
     virtual Formula simple(){
-        return shared_from_this();
+        return this;
     }
 
 };
 
 class Forall : public Quantifier {
 public:
-    Forall(const Variable & v, const Formula & op)
+    Forall(PointId v, const Formula & op)
         :Quantifier(v, op)
     {}
 
@@ -718,9 +818,9 @@ public:
     {
         return T_FORALL;
     }
-    virtual void printConvertedFormula(ostream & ostr)
+    virtual void printConvertedFormula(ostream & ostr, TranslationContext & ctx)
     {
-        cout << "![" << _v << "] : ";
+        ostr << "![" << SymbolTable::name(_v) << "] : ";
 
         Type op_type = _op->getType();
 
@@ -728,7 +828,7 @@ public:
                 op_type == T_IMP || op_type == T_IFF)
             ostr << "(";
 
-        _op->printConvertedFormula(ostr);
+        _op->printConvertedFormula(ostr, ctx);
 
         if(op_type == T_AND || op_type == T_OR ||
                 op_type == T_IMP || op_type == T_IFF)
@@ -738,7 +838,7 @@ public:
 
 class Exists : public Quantifier {
 public:
-    Exists(const Variable & v, const Formula & op)
+    Exists(PointId v, const Formula & op)
         :Quantifier(v, op)
     {}
 
@@ -747,9 +847,9 @@ public:
         return T_EXISTS;
     }
 
-    virtual void printConvertedFormula(ostream & ostr)
+    virtual void printConvertedFormula(ostream & ostr, TranslationContext & ctx)
     {
-        cout  << "?[" << _v << "] : ";
+        ostr  << "?[" << SymbolTable::name(_v) << "] : ";
 
         Type op_type = _op->getType();
 
@@ -757,7 +857,7 @@ public:
                 op_type == T_IMP || op_type == T_IFF)
             ostr << "(";
 
-        _op->printConvertedFormula(ostr);
+        _op->printConvertedFormula(ostr, ctx);
 
         if(op_type == T_AND || op_type == T_OR ||
                 op_type == T_IMP || op_type == T_IFF)
@@ -776,14 +876,14 @@ public:
         return T_PLUS;
     }
 
-    virtual void printConvertedFormula(ostream & ostr) {
+    virtual void printConvertedFormula(ostream & ostr, TranslationContext & ctx) {
         ostr << "(";
 
-        _op1->printConvertedFormula(ostr);
+        _op1->printConvertedFormula(ostr, ctx);
 
         ostr << " + ";
 
-        _op2->printConvertedFormula(ostr);
+        _op2->printConvertedFormula(ostr, ctx);
 
         ostr << ")";
     }
@@ -791,32 +891,17 @@ public:
     virtual Formula simple() {
         const Formula simp_op1 = _op1->simple();
         const Formula simp_op2 = _op2->simple();
-        
-        if (simp_op1->getType() == T_LIT) // onda je i simp_op2 isto T_LIT
-        {
-            if(((Lit *)simp_op1.get())->getSymbol() == "0"){
-                if(simp_op2->getType() == T_LIT && ((Lit *)simp_op2.get())->getSymbol() == "0")
-                {
-                    // (0 + 0) = 0
-                    Formula f1 = make_shared<Lit>("0");
-                    return f1;    
-                }
-                else
-                {
-                    // (0 + x) = x;
-                    Formula f1 = simp_op2;
-                    return f1;    
-                }
-            }
-        }
-        
-        if (simp_op2->getType() == T_LIT && ((Lit *)simp_op2.get())->getSymbol() == "0"){
-            
-                Formula f2 = simp_op1; //(x + 0) = x
-                return f2;    
-        }
 
-        return make_shared<Plus>(simp_op1, simp_op2);
+        if (isConst(simp_op1) && isConst(simp_op2))
+            return createConst(constValue(simp_op1) + constValue(simp_op2));
+
+        if (isConst(simp_op1, 0))
+            return simp_op2; // (0 + x) = x
+
+        if (isConst(simp_op2, 0))
+            return simp_op1; // (x + 0) = x
+
+        return createPlus(simp_op1, simp_op2);
     }
 };
 
@@ -831,14 +916,14 @@ public:
         return T_MINUS;
     }
 
-    virtual void printConvertedFormula(ostream & ostr) {
+    virtual void printConvertedFormula(ostream & ostr, TranslationContext & ctx) {
         ostr << "(";
 
-        _op1->printConvertedFormula(ostr);
+        _op1->printConvertedFormula(ostr, ctx);
 
         ostr << " - ";
 
-        _op2->printConvertedFormula(ostr);
+        _op2->printConvertedFormula(ostr, ctx);
 
         ostr << ")";
     }
@@ -847,34 +932,17 @@ public:
         
         const Formula simp_op1 = _op1->simple();
         const Formula simp_op2 = _op2->simple();
-        if (simp_op1->getType() == T_LIT) // onda je i simp_op2 isto T_LIT
-        {
-            if(((Lit *)simp_op1.get())->getSymbol() == "0"){
-
-                PredicateSymbol minusSymbol;
-            
-                if(((Lit *)_op2.get())->getSymbol() == "0") {
-                    minusSymbol = "0"; // (0 - 0) = 0
-                }
-                else {
-                    minusSymbol = "-" + ((Lit *)_op2.get())->getSymbol(); // (0 - x) = x
-                }
-            
-                Formula f1 = make_shared<Lit>(minusSymbol);
-                return f1;    
-            }
-        }
-        
-        if (_op2->getType() == T_LIT)
-        {
-            if(((Lit *)_op2.get())->getSymbol() == "0"){
-            
-                Formula f2 = make_shared<Lit>(((Lit *)_op1.get())->getSymbol()); //(x - 0) = x
-                return f2;    
-            }
-        }
 
-        return make_shared<Minus>(simp_op1, simp_op2);
+        if (isConst(simp_op1) && isConst(simp_op2))
+            return createConst(constValue(simp_op1) - constValue(simp_op2));
+
+        if (isConst(simp_op2, 0))
+            return simp_op1; // (x - 0) = x
+
+        if (isConst(simp_op1, 0))
+            return createNegation(simp_op2); // (0 - x) = -x
+
+        return createMinus(simp_op1, simp_op2);
     }
 };
 
@@ -889,14 +957,14 @@ public:
         return T_TIMES;
     }
 
-    virtual void printConvertedFormula(ostream & ostr)  {
+    virtual void printConvertedFormula(ostream & ostr, TranslationContext & ctx)  {
         ostr << "(";
 
-        _op1->printConvertedFormula(ostr);
+        _op1->printConvertedFormula(ostr, ctx);
 
         ostr << " * ";
 
-        _op2->printConvertedFormula(ostr);
+        _op2->printConvertedFormula(ostr, ctx);
 
         ostr << ")";
     }
@@ -905,26 +973,30 @@ public:
         
         const Formula simp_op1 = _op1->simple();
         const Formula simp_op2 = _op2->simple();
-        
-        if (simp_op1->getType() == T_LIT)
-        {
 
-            if(((Lit *)simp_op1.get())->getSymbol() == "0"){
-                
-                Formula f1 = make_shared<Lit>("0");
-                return f1;    
-            }
-        }
-        if (simp_op2->getType() == T_LIT)
-        {
-            if(((Lit *)simp_op2.get())->getSymbol() == "0"){
-                
-                Formula f2 = make_shared<Lit>("0");
-                return f2;    
-            }
-        }
+        if (isConst(simp_op1) && isConst(simp_op2))
+            return createConst(constValue(simp_op1) * constValue(simp_op2));
+
+        if (isConst(simp_op1, 0) || isConst(simp_op2, 0))
+            return createConst(0);
+
+        if (isConst(simp_op1, 1))
+            return simp_op2;
+
+        if (isConst(simp_op2, 1))
+            return simp_op1;
+
+        if (isConst(simp_op1, -1))
+            return createNegation(simp_op2);
 
-        return make_shared<Times>(simp_op1, simp_op2);
+        if (isConst(simp_op2, -1))
+            return createNegation(simp_op1);
+
+        // (-x * -y) = (x * y)
+        if (isNegative(simp_op1) && isNegative(simp_op2))
+            return createTimes(createNegation(simp_op1), createNegation(simp_op2));
+
+        return createTimes(simp_op1, simp_op2);
     }
 
 };
@@ -941,15 +1013,15 @@ public:
         return T_POW;
     }
 
-    virtual void printConvertedFormula(ostream & ostr)  {
+    virtual void printConvertedFormula(ostream & ostr, TranslationContext & ctx)  {
         
         if(_op->getType() == T_LIT){
             ostr << "("; 
-            _op->printConvertedFormula(ostr);
+            _op->printConvertedFormula(ostr, ctx);
             ostr << ")";
         }
         else {
-            _op->printConvertedFormula(ostr);
+            _op->printConvertedFormula(ostr, ctx);
         }
         ostr << "^2";
     }
@@ -957,15 +1029,15 @@ public:
     virtual Formula simple() {
         
         const Formula simp_op1 = _op->simple();
-        
-        if (simp_op1->getType() == T_LIT)
-        {
-            if(((Lit *)simp_op1.get())->getSymbol() == "0"){
-                Formula f1 = make_shared<Lit>("0");
-                return f1;    
-            }
-        }
-        return make_shared<Pow>(simp_op1);
+
+        if (isConst(simp_op1))
+            return createConst(constValue(simp_op1) * constValue(simp_op1));
+
+        // (-x)^2 = x^2
+        if (isNegative(simp_op1))
+            return createPow(createNegation(simp_op1));
+
+        return createPow(simp_op1);
     }
 
 };
@@ -981,14 +1053,14 @@ public:
         return T_EQ;
     }
 
-    virtual void printConvertedFormula(ostream & ostr) {
+    virtual void printConvertedFormula(ostream & ostr, TranslationContext & ctx) {
         ostr << "(";
 
-        _op1->printConvertedFormula(ostr);
+        _op1->printConvertedFormula(ostr, ctx);
 
         ostr << " = ";
 
-        _op2->printConvertedFormula(ostr);
+        _op2->printConvertedFormula(ostr, ctx);
 
         ostr << ")";
     }
@@ -997,19 +1069,20 @@ public:
         const Formula simp_op1 = _op1->simple();
         const Formula simp_op2 = _op2->simple();
 
-        if (simp_op1->getType() == T_LIT && simp_op2->getType() == T_LIT) {
-            if(((Lit *)simp_op1.get())->getSymbol() == "0" && ((Lit *)simp_op2.get())->getSymbol() == "0"){
-                Formula f1 = make_shared<True>();
-                return f1;    
-            }
+        // Skracuju se samo jednakosti konstanti, kakve nastaju sa -o;
+        // (x = x) za koordinatu x ostaje u ispisu kao i ranije.
+        // Konstante su jedinstveni cvorovi, pa su jednake tacno kada
+        // su pokazivaci jednaki.
+        if (isConst(simp_op1) && isConst(simp_op2)) {
+            Formula f1 = simp_op1 == simp_op2 ? (Formula)makeNode<True>()
+                                              : (Formula)makeNode<False>();
+            return f1;
         }
 
-        return make_shared<Equal>(simp_op1, simp_op2);
+        return createEqual(simp_op1, simp_op2);
     }
 };
 
-Formula createMinus(const string str1, const string str2);
-
 inline
 ostream & operator << (ostream & ostr, const Term & t)
 {
@@ -1020,10 +1093,9 @@ ostream & operator << (ostream & ostr, const Term & t)
 inline
 ostream & operator << (ostream & ostr, const Formula & f)
 {
-    f->printConvertedFormula(ostr);
+    TranslationContext ctx;
+    f->printConvertedFormula(ostr, ctx);
     return ostr;
 }
 
-extern Formula parsed_formula;
-
 #endif // _FOL_H
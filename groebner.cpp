@@ -0,0 +1,196 @@
+#include "groebner.hpp"
+
+#include <algorithm>
+
+void GroebnerBasis::add(const Polynomial & p)
+{
+    if(!p.isZero())
+        _pending.push_back(p);
+}
+
+int GroebnerBasis::reducer(const Monomial & m) const
+{
+    for(unsigned k = 0; k < _polys.size(); k++)
+        if(_active[k] && _polys[k].leadingMonomial().divides(m))
+            return k;
+    return -1;
+}
+
+Polynomial GroebnerBasis::normalForm(const Polynomial & p) const
+{
+    // Polinomi baze su monicni, pa je koeficijent mnozioca bas
+    // koeficijent terma koji se ponistava.
+    Polynomial::Terms result;
+    Polynomial q = p;
+
+    while(!q.isZero()) {
+        const Polynomial::Term & t = q.terms()[0];
+        int k = reducer(t.first);
+        if(k >= 0)
+            q = q - _polys[k].times(t.first / _polys[k].leadingMonomial(), t.second);
+        else {
+            result.push_back(t);
+            q = Polynomial(Polynomial::Terms(q.terms().begin() + 1, q.terms().end()));
+        }
+    }
+
+    return Polynomial(move(result));
+}
+
+/* Kriterijumi Gebauera i Melera za novi polinom h (Becker, Weispfenning,
+   procedura UPDATE):
+   - od novih parova (h, g) sa istim NZS ostaje jedan, a odbacuju se oni
+     ciji je NZS deljiv NZS-om nekog drugog novog para;
+   - zatim se odbacuju parovi sa uzajamno prostim vodecim monomima;
+   - stari par (g1, g2) se odbacuje ako lm(h) deli njegov NZS, a NZS-ovi
+     parova (g1, h) i (h, g2) su od njega razliciti. */
+void GroebnerBasis::update(unsigned h)
+{
+    const Monomial & lh = _polys[h].leadingMonomial();
+
+    vector<Pair> candidates;
+    for(unsigned g = 0; g < h; g++)
+        if(_active[g])
+            candidates.push_back(Pair(g, h, Monomial::lcm(_polys[g].leadingMonomial(), lh)));
+    _statistics.pairs += candidates.size();
+
+    vector<Pair> kept;
+    for(unsigned c = 0; c < candidates.size(); c++) {
+        const Pair & p = candidates[c];
+        bool coprime = _polys[p.i].leadingMonomial().isCoprime(lh);
+
+        bool redundant = false;
+        if(!coprime) {
+            for(unsigned d = c + 1; d < candidates.size() && !redundant; d++)
+                redundant = candidates[d].lcm.divides(p.lcm);
+            for(unsigned d = 0; d < kept.size() && !redundant; d++)
+                redundant = kept[d].lcm.divides(p.lcm);
+        }
+
+        if(!redundant)
+            kept.push_back(p);
+    }
+
+    vector<Pair> pairs;
+    for(const Pair & p : _pairs) {
+        if(lh.divides(p.lcm) &&
+                Monomial::lcm(_polys[p.i].leadingMonomial(), lh) != p.lcm &&
+                Monomial::lcm(_polys[p.j].leadingMonomial(), lh) != p.lcm)
+            continue;
+        pairs.push_back(p);
+    }
+
+    for(const Pair & p : kept)
+        if(!_polys[p.i].leadingMonomial().isCoprime(lh))
+            pairs.push_back(p);
+
+    _statistics.eliminated += _pairs.size() + candidates.size() - pairs.size();
+    _pairs.swap(pairs);
+
+    for(unsigned g = 0; g < h; g++)
+        if(_active[g] && lh.divides(_polys[g].leadingMonomial()))
+            _active[g] = false;
+}
+
+void GroebnerBasis::insert(const Polynomial & h)
+{
+    _polys.push_back(h.monic());
+    _active.push_back(false);
+    update(_polys.size() - 1);
+    _active.back() = true;
+
+    if(h.isConstant()) {
+        _unit = true;
+        _pairs.clear();
+    }
+}
+
+void GroebnerBasis::compute()
+{
+    OrderScope scope(_order);
+
+    vector<Polynomial> pending;
+    pending.swap(_pending);
+    for(const Polynomial & p : pending) {
+        if(_unit)
+            return;
+        Polynomial h = normalForm(p.sorted());
+        if(!h.isZero())
+            insert(h);
+    }
+
+    if(_algorithm != buchbergerAlgorithm)
+        f4();
+    else
+        buchberger();
+}
+
+void GroebnerBasis::buchberger()
+{
+    while(!_pairs.empty() && !_unit) {
+        auto next = min_element(_pairs.begin(), _pairs.end(), [](const Pair & p1, const Pair & p2) {
+            return Monomial::compare(p1.lcm, p2.lcm, Polynomial::order) < 0;
+        });
+        Pair p = *next;
+        *next = _pairs.back();
+        _pairs.pop_back();
+
+        const Polynomial & f = _polys[p.i];
+        const Polynomial & g = _polys[p.j];
+        Polynomial s = f.times(p.lcm / f.leadingMonomial(), 1) -
+                g.times(p.lcm / g.leadingMonomial(), 1);
+
+        Polynomial h = normalForm(s);
+        if(h.isZero())
+            _statistics.zeroReductions++;
+        else
+            insert(h);
+    }
+}
+
+vector<Polynomial> GroebnerBasis::basis() const
+{
+    OrderScope scope(_order);
+
+    vector<Polynomial> result;
+    for(unsigned k = 0; k < _polys.size(); k++) {
+        if(!_active[k])
+            continue;
+
+        // Termovi repa su manji od vodeceg, pa ih lm(k) ne deli.
+        const Polynomial::Terms & terms = _polys[k].terms();
+        Polynomial tail = normalForm(Polynomial(Polynomial::Terms(terms.begin() + 1, terms.end())));
+        result.push_back(Polynomial(terms[0].first) + tail);
+    }
+
+    sort(result.begin(), result.end(), [](const Polynomial & p1, const Polynomial & p2) {
+        return Monomial::compare(p1.leadingMonomial(), p2.leadingMonomial(), Polynomial::order) > 0;
+    });
+    return result;
+}
+
+Polynomial GroebnerBasis::reduce(const Polynomial & p) const
+{
+    OrderScope scope(_order);
+    return normalForm(p.sorted());
+}
+
+bool GroebnerBasis::radicalContains(const Polynomial & p) const
+{
+    if(_unit || contains(p))
+        return true;
+
+    Var t = 0;
+    for(const Polynomial & q : _polys)
+        for(const auto & term : q.terms())
+            if(!term.first.isOne())
+                t = max(t, term.first.lastVariable() + 1);
+    for(const auto & term : p.terms())
+        if(!term.first.isOne())
+            t = max(t, term.first.lastVariable() + 1);
+
+    GroebnerBasis extended = *this;
+    extended.add(Polynomial(1) - Polynomial::variable(t) * p);
+    extended.compute();
+    return extended.isUnit();
+}
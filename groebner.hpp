@@ -0,0 +1,122 @@
+#ifndef _GROEBNER_H
+#define _GROEBNER_H
+
+#include <vector>
+
+#include "polynomial.hpp"
+
+using namespace std;
+
+/* Grebnerova baza ideala nad racionalnim brojevima, Buhbergerovim
+   algoritmom. Parovi se biraju po najmanjem NZS vodecih monoma
+   (normalna strategija), a suvisni parovi se odbacuju kriterijumima
+   Gebauera i Melera pre redukcije. Baza se racuna u svom uredjenju
+   monoma, nezavisno od Polynomial::order pozivaoca.
+
+   Baza se moze prosirivati: posle add, compute obradjuje samo parove
+   sa novim polinomima. Koeficijenti su tipa Rational, proizvoljne
+   velicine. */
+enum groebnerAlgorithm {
+    buchbergerAlgorithm,    // jedan S-polinom po koraku
+    f4Algorithm,            // svi parovi istog stepena odjednom, kao matrica (f4.cpp)
+    f4ModularAlgorithm      // F4 sa eliminacijom po vise prostih brojeva (modular.hpp)
+};
+
+class GroebnerBasis {
+public:
+    GroebnerBasis(MonomialOrder order = GREVLEX,
+                  groebnerAlgorithm algorithm = buchbergerAlgorithm)
+        :_order(order),
+          _algorithm(algorithm),
+          _unit(false)
+    {}
+
+    MonomialOrder order() const
+    {
+        return _order;
+    }
+
+    /* Dodaje generator ideala; uredjenje polinoma nije bitno. */
+    void add(const Polynomial & p);
+
+    /* Dovrsava bazu za sve dodate generatore. */
+    void compute();
+
+    /* Redukovana baza (posle compute), sortirana u uredjenju order(). */
+    vector<Polynomial> basis() const;
+
+    /* Normalna forma p u odnosu na bazu, u uredjenju order(). */
+    Polynomial reduce(const Polynomial & p) const;
+
+    bool contains(const Polynomial & p) const
+    {
+        return reduce(p).isZero();
+    }
+
+    /* Da li je p u radikalu ideala: 1 je u idealu prosirenom sa
+       1 - t * p, gde je t nova promenljiva (Rabinovicev trik). */
+    bool radicalContains(const Polynomial & p) const;
+
+    /* Da li je ideal ceo prsten, tj. baza sadrzi konstantu. */
+    bool isUnit() const
+    {
+        return _unit;
+    }
+
+    struct Statistics {
+        Statistics()
+            :pairs(0),
+              eliminated(0),
+              zeroReductions(0),
+              matrices(0),
+              liftedMatrices(0)
+        {}
+
+        unsigned pairs;             // svi napravljeni parovi
+        unsigned eliminated;        // odbaceni kriterijumima
+        unsigned zeroReductions;    // S-polinomi koji su se sveli na 0
+        unsigned matrices;          // Makolijeve matrice (samo F4)
+        unsigned liftedMatrices;    // od njih dobijene rekonstrukcijom
+    };
+
+    const Statistics & statistics() const
+    {
+        return _statistics;
+    }
+
+private:
+    struct Pair {
+        Pair(unsigned i, unsigned j, const Monomial & lcm)
+            :i(i),
+              j(j),
+              lcm(lcm)
+        {}
+
+        unsigned i, j;
+        Monomial lcm;
+    };
+
+    void buchberger();
+    void f4();
+
+    void insert(const Polynomial & h);
+    void update(unsigned h);
+    Polynomial normalForm(const Polynomial & p) const;
+    int reducer(const Monomial & m) const;
+
+    MonomialOrder _order;
+    groebnerAlgorithm _algorithm;
+    bool _unit;
+
+    /* Svi polinomi ikad dodati bazi; parovi se pozivaju na indekse.
+       Neaktivan je polinom ciji je vodeci monom deljiv vodecim monomom
+       nekog kasnijeg. */
+    vector<Polynomial> _polys;
+    vector<bool> _active;
+    vector<Polynomial> _pending;
+    vector<Pair> _pairs;
+
+    Statistics _statistics;
+};
+
+#endif // _GROEBNER_H
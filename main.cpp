@@ -1,19 +1,31 @@
 #include "fol.hpp"
+#include "nodefactory.hpp"
+#include "templates.hpp"
+#include "cache.hpp"
+#include "parsecontext.hpp"
+#include "batch.hpp"
+#include "pipeline.hpp"
+#include "mappedfile.hpp"
+#include "server.hpp"
+#include "sink.hpp"
+#include "binwriter.hpp"
+#include "prover.hpp"
 
+#include <memory>
 #include <string>
 #include <string.h>
-
-extern int yyparse();
-
-/* Ovaj pokazivac ce nakon parsiranja dobiti vrednost 
-   adrese parsirane formule. */
-extern Formula parsed_formula;
-extern bool exitIndicator;
-extern bool printIndicator;
+#include <stdlib.h>
+#include <unistd.h>
 
 int main(int argc, char* argv[])
 {
     bool optIndicator = false;
+    outputFormat format = infixOutput;
+    bool statsIndicator = false;
+    unsigned jobs = 0;
+    unsigned pipelineJobs = 0;
+    const char * inputPath = nullptr;
+    const char * listenPath = nullptr;
 
     for(int i = 1; i < argc ;i++){
         
@@ -21,6 +33,100 @@ int main(int argc, char* argv[])
             optIndicator = true;
             
         }
+
+        if(strcmp(argv[i], "-p") == 0 && format == infixOutput){
+            format = normalFormOutput;
+        }
+
+        if(strcmp(argv[i], "-b") == 0){
+            format = binaryOutput;
+        }
+
+        if(strcmp(argv[i], "--smt") == 0){
+            format = smtOutput;
+        }
+
+        if(strcmp(argv[i], "--prove") == 0){
+            format = proofOutput;
+        }
+
+        if(strcmp(argv[i], "--engine") == 0){
+            const char * name = i + 1 < argc ? argv[++i] : "";
+            if(strcmp(name, "buchberger") == 0)
+                ProverOptions::commandLine.engine = groebnerEngine;
+            else if(strcmp(name, "f4") == 0)
+                ProverOptions::commandLine.engine = f4Engine;
+            else if(strcmp(name, "wu") == 0)
+                ProverOptions::commandLine.engine = wuEngine;
+            else if(strcmp(name, "random") == 0)
+                ProverOptions::commandLine.engine = randomEngine;
+            else {
+                cerr << "--engine expects buchberger, f4, wu or random" << endl;
+                return 1;
+            }
+        }
+
+        if(strcmp(argv[i], "--modular") == 0){
+            ProverOptions::commandLine.modular = true;
+        }
+
+        if(strcmp(argv[i], "--instances") == 0){
+            if(i + 1 == argc || atoi(argv[i + 1]) <= 0){
+                cerr << "--instances expects a positive number" << endl;
+                return 1;
+            }
+            ProverOptions::commandLine.instances = atoi(argv[++i]);
+        }
+
+        if(strcmp(argv[i], "--order") == 0){
+            const char * name = i + 1 < argc ? argv[++i] : "";
+            if(strcmp(name, "lex") == 0)
+                ProverOptions::commandLine.order = LEX;
+            else if(strcmp(name, "grlex") == 0)
+                ProverOptions::commandLine.order = GRLEX;
+            else if(strcmp(name, "grevlex") == 0)
+                ProverOptions::commandLine.order = GREVLEX;
+            else {
+                cerr << "--order expects lex, grlex or grevlex" << endl;
+                return 1;
+            }
+        }
+
+        if(strcmp(argv[i], "-s") == 0){
+            statsIndicator = true;
+        }
+
+        if(strcmp(argv[i], "--jobs") == 0){
+            if(i + 1 == argc || atoi(argv[i + 1]) <= 0){
+                cerr << "--jobs expects a positive number of threads" << endl;
+                return 1;
+            }
+            jobs = atoi(argv[++i]);
+        }
+
+        if(strcmp(argv[i], "--pipeline") == 0){
+            if(i + 1 == argc || atoi(argv[i + 1]) <= 0){
+                cerr << "--pipeline expects a positive number of threads" << endl;
+                return 1;
+            }
+            pipelineJobs = atoi(argv[++i]);
+        }
+
+        if(strcmp(argv[i], "--input") == 0){
+            if(i + 1 == argc){
+                cerr << "--input expects a file name" << endl;
+                return 1;
+            }
+            inputPath = argv[++i];
+        }
+
+        if(strcmp(argv[i], "--listen") == 0){
+            if(i + 1 == argc){
+                cerr << "--listen expects a socket path" << endl;
+                return 1;
+            }
+            listenPath = argv[++i];
+        }
         
         if(strcmp(argv[i], "-h") == 0){
             cout <<  "USE: \n"
@@ -30,26 +136,126 @@ int main(int argc, char* argv[])
                  <<  "perpendicular(A1, A2, A3, A4)  \n"
                  <<  "is_midpoint(A1, A2, A3)  \n"
                  <<  "is_intersection(A1, A2, A3, A4, A5)  \n"
-                 <<  "is_equal(A2, A2) \n\n" << endl;
+                 <<  "is_equal(A2, A2) \n\n"
+                 <<  "OPTIONS: \n"
+                 <<  "-o   fix the first point at (0, 0) and the second on the y axis \n"
+                 <<  "-p   print equations in normal form p = 0 \n"
+                 <<  "-b   write polynomial systems in binary form (see binreader.hpp) \n"
+                 <<  "--smt   write each statement as an SMT-LIB2 script (QF_NRA) \n"
+                 <<  "--prove   decide H => C: is the conclusion in the radical of the hypothesis ideal \n"
+                 <<  "--engine E   prover for --prove: buchberger (default), f4, wu or random \n"
+                 <<  "--modular   with --engine f4, eliminate modulo several primes and lift the result \n"
+                 <<  "--instances N   with --engine random, number of random instances (default 32) \n"
+                 <<  "--order O   monomial order for --prove: lex, grlex or grevlex (default) \n"
+                 <<  "-s   print translation cache statistics to stderr \n"
+                 <<  "--jobs N   translate on N threads, output stays in input order \n"
+                 <<  "--pipeline N   parse, translate (on N threads) and write in parallel stages \n"
+                 <<  "--input FILE   read statements from FILE (memory mapped) instead of stdin \n"
+                 <<  "--listen PATH   serve statements over a Unix socket at PATH (--jobs N threads) \n\n" << endl;
         }
         
     }
 
-    while(true){
+    if(ProverOptions::commandLine.modular && ProverOptions::commandLine.engine != f4Engine){
+        cerr << "--modular can only be used with --engine f4" << endl;
+        return 1;
+    }
+
+    /* Svi cvorovi jedne naredbe se prave u ovoj areni i oslobadjaju
+       se odjednom na kraju iteracije. */
+    Arena arena;
+    Arena::setCurrent(&arena);
 
-        yyparse();
+    RelationTemplate::init();
+
+    /* Sa --listen program radi kao server do kraja procesa. */
+    if(listenPath != nullptr){
+        if(format == binaryOutput || format == smtOutput){
+            cerr << (format == binaryOutput ? "-b" : "--smt") << " cannot be used with --listen" << endl;
+            return 1;
+        }
+        try {
+            Server server(listenPath, jobs > 0 ? jobs : 1, optIndicator, format);
+            server.run();
+        }
+        catch(const exception & e){
+            cerr << e.what() << endl;
+            return 1;
+        }
+    }
+
+    /* Sa --input se datoteka mapira u memoriju i skenira u mestu. */
+    unique_ptr<MappedFile> input;
+    if(inputPath != nullptr){
+        try {
+            input.reset(new MappedFile(inputPath));
+        }
+        catch(const exception & e){
+            cerr << e.what() << endl;
+            return 1;
+        }
+    }
 
-        if(exitIndicator)
-            break;
+    /* Prevodi idu u bafer nad standardnim izlazom koji se prazni u
+       velikim blokovima; samo kada se naredbe kucaju na terminalu
+       prazni se posle svake naredbe. */
+    FileSink sink(STDOUT_FILENO);
+    ostream out(&sink);
+    bool interactive = !input && isatty(STDIN_FILENO);
 
-        if(printIndicator)
-            parsed_formula.get()->doTheMagic(optIndicator, cout);
+    if(format == binaryOutput)
+        writeBinaryHeader(out);
+
+    if(pipelineJobs > 0){
+        Pipeline pipeline(pipelineJobs, optIndicator, format);
+        if(input)
+            pipeline.run(input->data(), input->size(), out);
+        else
+            pipeline.run(stdin, out);
+    }
+    else if(jobs > 0){
+        BatchTranslator batch(jobs, optIndicator, format);
+        if(input)
+            batch.run(input->data(), input->size(), out);
         else
-            cout << endl;
+            batch.run(stdin, out);
+    }
+    else {
+        /* Nakon parsiranja naredbe ctx.parsedFormula je adresa
+           parsirane formule. */
+        ParseContext ctx(stdin);
+        if(input)
+            ctx.scanInPlace(input->data(), input->size());
+
+        while(true){
+
+            ctx.parse();
 
-        printIndicator = false;
+            if(ctx.exitIndicator)
+                break;
+
+            if(ctx.printIndicator)
+                ctx.parsedFormula->doTheMagic(optIndicator, format, out);
+            else
+                printStatementError(ctx.errorMessage, format, out);
+
+            if(interactive)
+                out.flush();
+
+            NodeFactory::clear();
+            arena.release();
+        }
     }
 
-    cout << endl;
+    if(format == binaryOutput)
+        out.flush();
+    else
+        out << endl;
+
+    if(statsIndicator)
+        cerr << "cache: " << TranslationCache::hits() << " hits, "
+             << TranslationCache::misses() << " misses, "
+             << TranslationCache::size() << " entries" << endl;
+
     return 0;
 }
@@ -0,0 +1,70 @@
+#include "mappedfile.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+static runtime_error mapError(const char * path)
+{
+    return runtime_error(string("cannot map ") + path + ": " + strerror(errno));
+}
+
+MappedFile::MappedFile(const char * path)
+    :_data(nullptr),
+      _size(0),
+      _mapped(0)
+{
+    int fd = open(path, O_RDONLY);
+    if(fd < 0)
+        throw mapError(path);
+
+    struct stat st;
+    if(fstat(fd, &st) < 0) {
+        runtime_error e = mapError(path);
+        close(fd);
+        throw e;
+    }
+    _size = st.st_size;
+
+    // Prvo anonimno mapiranje za sadrzaj i dva nula bajta, pa preko
+    // njega datoteka. Bajtovi iza kraja datoteke su tako uvek nule,
+    // i kada se datoteka zavrsava tacno na granici stranice.
+    long page = sysconf(_SC_PAGESIZE);
+    _mapped = (_size + 2 + page - 1) / page * page;
+
+    void * base = mmap(nullptr, _mapped, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(base == MAP_FAILED) {
+        runtime_error e = mapError(path);
+        close(fd);
+        throw e;
+    }
+
+    if(_size > 0) {
+        void * file = mmap(base, _size, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_FIXED, fd, 0);
+        if(file == MAP_FAILED) {
+            runtime_error e = mapError(path);
+            munmap(base, _mapped);
+            close(fd);
+            throw e;
+        }
+        madvise(base, _size, MADV_SEQUENTIAL);
+    }
+
+    close(fd);
+    _data = (char *)base;
+}
+
+MappedFile::~MappedFile()
+{
+    munmap(_data, _mapped);
+}
@@ -0,0 +1,36 @@
+#ifndef _MAPPEDFILE_H
+#define _MAPPEDFILE_H
+
+#include <cstddef>
+
+/* Datoteka mapirana u memoriju (mmap), pripremljena za skeniranje u
+   mestu: iza sadrzaja slede dva nula bajta koja yy_scan_buffer zahteva.
+   Mapiranje je privatno, pa se privremene izmene skenera ne upisuju u
+   datoteku; kopiju dobijaju samo stranice koje skener zaista menja. */
+class MappedFile {
+public:
+    /* Baca runtime_error ako datoteka ne moze da se mapira. */
+    MappedFile(const char * path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile & operator = (const MappedFile &) = delete;
+
+    char * data()
+    {
+        return _data;
+    }
+
+    /* Velicina sadrzaja, bez zavrsnih nula bajtova. */
+    size_t size() const
+    {
+        return _size;
+    }
+
+private:
+    char * _data;
+    size_t _size;
+    size_t _mapped;
+};
+
+#endif // _MAPPEDFILE_H
@@ -0,0 +1,231 @@
+#include "modular.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(NO_AVX2)
+#include <immintrin.h>
+#define MODULAR_AVX2 1
+#endif
+
+static const uint32_t primes[] = {
+    2147483647u, 2147483629u, 2147483587u, 2147483579u,
+    2147483563u, 2147483549u, 2147483543u, 2147483497u,
+    2147483489u, 2147483477u, 2147483423u, 2147483399u,
+    2147483353u, 2147483323u, 2147483269u, 2147483249u
+};
+
+uint32_t PrimeField::prime(unsigned i)
+{
+    return primes[i];
+}
+
+unsigned PrimeField::primeCount()
+{
+    return sizeof(primes) / sizeof(primes[0]);
+}
+
+PrimeField::PrimeField(uint32_t p)
+    :_p(p)
+{
+    if(p < 3 || p >= (1u << 31) || p % 2 == 0)
+        throw invalid_argument("PrimeField: modulus must be an odd prime below 2^31");
+
+    _barrett = (uint64_t)(((unsigned __int128)1 << 64) / p);
+    _r = (uint32_t)(((uint64_t)1 << 32) % p);
+
+    // Njutnov postupak: svaki korak udvostrucuje broj tacnih bitova.
+    uint32_t inv = p;
+    for(int i = 0; i < 4; i++)
+        inv *= 2 - p * inv;
+    _pinv = -inv;
+}
+
+uint32_t PrimeField::inverse(uint32_t a) const
+{
+    if(a == 0)
+        throw domain_error("PrimeField: inverse of zero");
+
+    int64_t r0 = _p, r1 = a, s0 = 0, s1 = 1;
+    while(r1 != 0) {
+        int64_t q = r0 / r1;
+        int64_t t = r0 - q * r1;
+        r0 = r1;
+        r1 = t;
+        t = s0 - q * s1;
+        s0 = s1;
+        s1 = t;
+    }
+    return (uint32_t)(s0 < 0 ? s0 + _p : s0);
+}
+
+uint32_t PrimeField::fromInteger(int64_t a) const
+{
+    uint32_t r = reduce(a < 0 ? -(uint64_t)a : (uint64_t)a);
+    return a < 0 ? neg(r) : r;
+}
+
+bool PrimeField::fromRational(const Rational & r, uint32_t & result) const
+{
+    if(r.isSmall() && r.isInteger()) {
+        result = fromInteger(r.num());
+        return true;
+    }
+
+    uint32_t num, den;
+    r.residues(_p, num, den);
+    if(den == 0)
+        return false;
+    result = mul(num, inverse(den));
+    return true;
+}
+
+static void subtractMultipleScalar(const PrimeField & field, uint32_t * y, const uint32_t * x,
+                                   uint32_t a, size_t n)
+{
+    uint32_t b = field.neg(a);
+    for(size_t i = 0; i < n; i++)
+        y[i] = field.add(y[i], field.mul(b, x[i]));
+}
+
+#ifdef MODULAR_AVX2
+
+/* Osam Montgomerijevih svodjenja odjednom: za t = b * x < p * 2^32,
+   (t + ((t * pinv) mod 2^32) * p) / 2^32 je b * x / 2^32 mod p, u [0, 2p).
+   _mm256_mul_epu32 mnozi samo parne 32-bitne clanove, pa se neparni
+   obradjuju posle pomeranja i vracaju mesanjem. */
+__attribute__((target("avx2")))
+static void subtractMultipleAvx2(uint32_t * y, const uint32_t * x, size_t n,
+                                 uint32_t p, uint32_t pinv, uint32_t b)
+{
+    const __m256i P = _mm256_set1_epi32(p);
+    const __m256i PINV = _mm256_set1_epi32(pinv);
+    const __m256i B = _mm256_set1_epi32(b);
+
+    size_t i = 0;
+    for(; i + 8 <= n; i += 8) {
+        __m256i vx = _mm256_loadu_si256((const __m256i *)(x + i));
+
+        __m256i te = _mm256_mul_epu32(vx, B);
+        __m256i me = _mm256_mul_epu32(te, PINV);
+        __m256i ue = _mm256_srli_epi64(_mm256_add_epi64(te, _mm256_mul_epu32(me, P)), 32);
+
+        __m256i xo = _mm256_srli_epi64(vx, 32);
+        __m256i to = _mm256_mul_epu32(xo, B);
+        __m256i mo = _mm256_mul_epu32(to, PINV);
+        __m256i uo = _mm256_add_epi64(to, _mm256_mul_epu32(mo, P));
+
+        // Gornje polovine neparnih zbirova su vec na neparnim mestima.
+        __m256i u = _mm256_blend_epi32(ue, uo, 0xAA);
+        u = _mm256_min_epu32(u, _mm256_sub_epi32(u, P));
+
+        __m256i vy = _mm256_loadu_si256((const __m256i *)(y + i));
+        __m256i s = _mm256_add_epi32(vy, u);
+        s = _mm256_min_epu32(s, _mm256_sub_epi32(s, P));
+        _mm256_storeu_si256((__m256i *)(y + i), s);
+    }
+
+    for(; i < n; i++) {
+        uint64_t t = (uint64_t)x[i] * b;
+        uint32_t m = (uint32_t)t * pinv;
+        uint32_t u = (uint32_t)((t + (uint64_t)m * p) >> 32);
+        if(u >= p)
+            u -= p;
+        uint32_t s = y[i] + u;
+        y[i] = s >= p ? s - p : s;
+    }
+}
+
+static bool hasAvx2()
+{
+    static const bool has = (__builtin_cpu_init(), __builtin_cpu_supports("avx2"));
+    return has;
+}
+
+#endif
+
+bool PrimeField::vectorized()
+{
+#ifdef MODULAR_AVX2
+    return hasAvx2();
+#else
+    return false;
+#endif
+}
+
+void PrimeField::subtractMultiple(uint32_t * y, const uint32_t * x, uint32_t a, size_t n) const
+{
+#ifdef MODULAR_AVX2
+    if(hasAvx2()) {
+        subtractMultipleAvx2(y, x, n, _p, _pinv, montgomery(neg(a)));
+        return;
+    }
+#endif
+    subtractMultipleScalar(*this, y, x, a, n);
+}
+
+void PrimeField::scale(uint32_t * y, uint32_t a, size_t n) const
+{
+    for(size_t i = 0; i < n; i++)
+        y[i] = mul(y[i], a);
+}
+
+ChineseRemainder::ChineseRemainder(const vector<uint32_t> & primes)
+    :_modulus(1)
+{
+    if(primes.empty() || primes.size() > 4)
+        throw invalid_argument("ChineseRemainder: expects one to four primes");
+
+    for(uint32_t p : primes) {
+        _fields.push_back(PrimeField(p));
+        _inverses.push_back(_fields.back().inverse((uint32_t)(_modulus % p)));
+        _modulus *= p;
+    }
+
+    // Celobrojni koren od M / 2, popravljen posle priblizne vrednosti.
+    unsigned __int128 half = _modulus / 2;
+    unsigned __int128 s = (unsigned __int128)sqrtl((long double)half);
+    while(s * s > half)
+        s--;
+    while((s + 1) * (s + 1) <= half)
+        s++;
+    _bound = s;
+}
+
+bool ChineseRemainder::rational(const uint32_t * residues, Rational & result) const
+{
+    // Garner: x = r0 + p0 * (t1 + p1 * (t2 + ...)).
+    unsigned __int128 x = residues[0];
+    unsigned __int128 m = _fields[0].prime();
+    for(unsigned i = 1; i < _fields.size(); i++) {
+        const PrimeField & field = _fields[i];
+        uint32_t xi = (uint32_t)(x % field.prime());
+        uint32_t t = field.mul(field.sub(residues[i], xi), _inverses[i]);
+        x += m * t;
+        m *= field.prime();
+    }
+
+    // Prosireni Euklid nad (M, x) do prvog ostatka ispod granice.
+    unsigned __int128 r0 = _modulus, r1 = x;
+    __int128 s0 = 0, s1 = 1;
+    while(r1 > _bound) {
+        unsigned __int128 q = r0 / r1;
+        unsigned __int128 t = r0 - q * r1;
+        r0 = r1;
+        r1 = t;
+        __int128 u = s0 - (__int128)q * s1;
+        s0 = s1;
+        s1 = u;
+    }
+
+    __int128 num = r1, den = s1;
+    if(den < 0) {
+        num = -num;
+        den = -den;
+    }
+    if(den == 0 || den > (__int128)_bound || num > INT64_MAX || den > INT64_MAX)
+        return false;
+
+    result = Rational((int64_t)num, (int64_t)den);
+    return result.den() == (int64_t)den;
+}
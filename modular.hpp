@@ -0,0 +1,112 @@
+#ifndef _MODULAR_H
+#define _MODULAR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "rational.hpp"
+
+using namespace std;
+
+/* Aritmetika u polju ostataka po prostom broju p < 2^31. Elementi su
+   uint32_t u [0, p). Pojedinacni proizvodi se svode Barretovim
+   postupkom; kernel subtractMultiple, na kome se zasniva eliminacija
+   (vidi f4.cpp), koristi Montgomerijevo svodjenje i AVX2 kada ga
+   procesor ima, a inace skalarni kod sa istim rezultatom; prevod sa
+   -DNO_AVX2 uvek bira skalarni kod. */
+class PrimeField {
+public:
+    explicit PrimeField(uint32_t p);
+
+    uint32_t prime() const
+    {
+        return _p;
+    }
+
+    uint32_t add(uint32_t a, uint32_t b) const
+    {
+        uint32_t s = a + b;
+        return s >= _p ? s - _p : s;
+    }
+
+    uint32_t sub(uint32_t a, uint32_t b) const
+    {
+        return a >= b ? a - b : a + _p - b;
+    }
+
+    uint32_t neg(uint32_t a) const
+    {
+        return a == 0 ? 0 : _p - a;
+    }
+
+    uint32_t mul(uint32_t a, uint32_t b) const
+    {
+        return reduce((uint64_t)a * b);
+    }
+
+    /* x mod p za svako x < 2^64, bez deljenja (Barret). */
+    uint32_t reduce(uint64_t x) const
+    {
+        uint64_t q = (uint64_t)(((unsigned __int128)x * _barrett) >> 64);
+        uint64_t r = x - q * _p;
+        return (uint32_t)(r >= _p ? r - _p : r);
+    }
+
+    /* a^-1; a ne sme biti 0. */
+    uint32_t inverse(uint32_t a) const;
+
+    uint32_t fromInteger(int64_t a) const;
+
+    /* Slika racionalnog broja; false ako p deli imenilac. */
+    bool fromRational(const Rational & r, uint32_t & result) const;
+
+    /* y[i] = y[i] - a * x[i] za i < n. */
+    void subtractMultiple(uint32_t * y, const uint32_t * x, uint32_t a, size_t n) const;
+
+    /* y[i] = a * y[i] za i < n. */
+    void scale(uint32_t * y, uint32_t a, size_t n) const;
+
+    /* i-ti prost broj iz fiksnog niza najvecih prostih brojeva ispod
+       2^31; niz ima primeCount() clanova. */
+    static uint32_t prime(unsigned i);
+    static unsigned primeCount();
+
+    /* Da li subtractMultiple koristi AVX2. */
+    static bool vectorized();
+
+private:
+    uint32_t _p;
+    uint64_t _barrett;      // floor(2^64 / p)
+    uint32_t _pinv;         // -p^-1 mod 2^32, za Montgomerijevo svodjenje
+    uint32_t _r;            // 2^32 mod p
+
+    /* a * 2^32 mod p: mnozilac za koji Montgomerijevo svodjenje
+       proizvoda sa x daje a * x mod p. */
+    uint32_t montgomery(uint32_t a) const
+    {
+        return mul(a, _r);
+    }
+};
+
+/* Kineska teorema o ostacima za fiksan skup od najvise cetiri prosta
+   broja (proizvod staje u 128 bita), i racionalna rekonstrukcija:
+   iz x mod M nalazi n/d sa |n|, d <= sqrt(M/2). Rekonstrukcija je
+   ispravna ako pravi razlomak staje u te granice; inace moze vratiti
+   pogresan broj, pa je pozivalac proverava na jos jednom prostom broju. */
+class ChineseRemainder {
+public:
+    explicit ChineseRemainder(const vector<uint32_t> & primes);
+
+    /* residues[i] je ostatak po primes[i]; false ako razlomak u
+       granicama ne postoji. */
+    bool rational(const uint32_t * residues, Rational & result) const;
+
+private:
+    vector<PrimeField> _fields;
+    vector<uint32_t> _inverses;     // (p0 * ... * p(i-1))^-1 mod pi, Garnerov postupak
+    unsigned __int128 _modulus;
+    unsigned __int128 _bound;       // floor(sqrt(M / 2))
+};
+
+#endif // _MODULAR_H
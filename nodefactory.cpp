@@ -0,0 +1,198 @@
+#include "nodefactory.hpp"
+
+thread_local vector<Formula> NodeFactory::_slots(1024, nullptr);
+thread_local vector<size_t> NodeFactory::_used;
+
+static size_t mix(size_t h, size_t v)
+{
+    return h ^ (v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+}
+
+size_t NodeFactory::hashConst(const Rational & value)
+{
+    return mix(value.hash(), BaseFormula::T_CONST);
+}
+
+size_t NodeFactory::hashCoordinate(PointId point, axis a, bool negated)
+{
+    return mix(mix(point, a), negated ? 2 * BaseFormula::T_LIT : BaseFormula::T_LIT);
+}
+
+size_t NodeFactory::hashNode(BaseFormula::Type type, Formula op1, Formula op2)
+{
+    size_t h = mix(hash<const void *>()(op1), type);
+    return mix(h, hash<const void *>()(op2));
+}
+
+bool NodeFactory::sameNode(Formula f, BaseFormula::Type type, Formula op1, Formula op2)
+{
+    if(f->getType() != type)
+        return false;
+
+    if(type == BaseFormula::T_POW)
+        return ((Pow *)f)->getOperand() == op1;
+
+    return ((BinaryConjective *)f)->getOperand1() == op1 &&
+            ((BinaryConjective *)f)->getOperand2() == op2;
+}
+
+Formula NodeFactory::insert(size_t slot, Formula f)
+{
+    _slots[slot] = f;
+    _used.push_back(slot);
+
+    if(2 * _used.size() > _slots.size())
+        grow();
+
+    return f;
+}
+
+void NodeFactory::grow()
+{
+    vector<Formula> old(2 * _slots.size(), nullptr);
+    old.swap(_slots);
+
+    size_t mask = _slots.size() - 1;
+    _used.clear();
+
+    for(Formula f : old) {
+        if(f == nullptr)
+            continue;
+
+        size_t h;
+        if(f->getType() == BaseFormula::T_LIT)
+            h = hashCoordinate(((Lit *)f)->getPoint(), ((Lit *)f)->getAxis(),
+                               ((Lit *)f)->isNegated());
+        else if(f->getType() == BaseFormula::T_CONST)
+            h = hashConst(((Const *)f)->getValue());
+        else if(f->getType() == BaseFormula::T_POW)
+            h = hashNode(BaseFormula::T_POW, ((Pow *)f)->getOperand(), nullptr);
+        else
+            h = hashNode(f->getType(), ((BinaryConjective *)f)->getOperand1(),
+                         ((BinaryConjective *)f)->getOperand2());
+
+        size_t slot = h & mask;
+        while(_slots[slot] != nullptr)
+            slot = (slot + 1) & mask;
+
+        _slots[slot] = f;
+        _used.push_back(slot);
+    }
+}
+
+Formula NodeFactory::constant(const Rational & value)
+{
+    size_t mask = _slots.size() - 1;
+    size_t slot = hashConst(value) & mask;
+
+    for(; _slots[slot] != nullptr; slot = (slot + 1) & mask) {
+        Formula f = _slots[slot];
+        if(f->getType() == BaseFormula::T_CONST && ((Const *)f)->getValue() == value)
+            return f;
+    }
+
+    return insert(slot, makeNode<Const>(value));
+}
+
+Formula NodeFactory::coordinate(PointId point, axis a, bool negated)
+{
+    size_t mask = _slots.size() - 1;
+    size_t slot = hashCoordinate(point, a, negated) & mask;
+
+    for(; _slots[slot] != nullptr; slot = (slot + 1) & mask) {
+        const Lit * l = (Lit *)_slots[slot];
+        if(l->getType() == BaseFormula::T_LIT && l->getPoint() == point &&
+                l->getAxis() == a && l->isNegated() == negated)
+            return _slots[slot];
+    }
+
+    return insert(slot, makeNode<Lit>(point, a, negated));
+}
+
+Formula NodeFactory::node(BaseFormula::Type type, Formula op1, Formula op2)
+{
+    size_t mask = _slots.size() - 1;
+    size_t slot = hashNode(type, op1, op2) & mask;
+
+    for(; _slots[slot] != nullptr; slot = (slot + 1) & mask)
+        if(sameNode(_slots[slot], type, op1, op2))
+            return _slots[slot];
+
+    Formula f;
+    switch(type){
+    case BaseFormula::T_PLUS:
+        f = makeNode<Plus>(op1, op2);
+        break;
+    case BaseFormula::T_MINUS:
+        f = makeNode<Minus>(op1, op2);
+        break;
+    case BaseFormula::T_TIMES:
+        f = makeNode<Times>(op1, op2);
+        break;
+    case BaseFormula::T_POW:
+        f = makeNode<Pow>(op1);
+        break;
+    case BaseFormula::T_EQ:
+        f = makeNode<Equal>(op1, op2);
+        break;
+    case BaseFormula::T_AND:
+        f = makeNode<And>(op1, op2);
+        break;
+    default:
+        return nullptr;
+    }
+
+    return insert(slot, f);
+}
+
+size_t NodeFactory::size()
+{
+    return _used.size();
+}
+
+void NodeFactory::clear()
+{
+    for(size_t slot : _used)
+        _slots[slot] = nullptr;
+    _used.clear();
+}
+
+Formula createConst(const Rational & value)
+{
+    return NodeFactory::constant(value);
+}
+
+Formula createCoordinate(PointId point, axis a, bool negated)
+{
+    return NodeFactory::coordinate(point, a, negated);
+}
+
+Formula createPlus(const Formula & op1, const Formula & op2)
+{
+    return NodeFactory::node(BaseFormula::T_PLUS, op1, op2);
+}
+
+Formula createMinus(const Formula & op1, const Formula & op2)
+{
+    return NodeFactory::node(BaseFormula::T_MINUS, op1, op2);
+}
+
+Formula createTimes(const Formula & op1, const Formula & op2)
+{
+    return NodeFactory::node(BaseFormula::T_TIMES, op1, op2);
+}
+
+Formula createPow(const Formula & op)
+{
+    return NodeFactory::node(BaseFormula::T_POW, op);
+}
+
+Formula createEqual(const Formula & op1, const Formula & op2)
+{
+    return NodeFactory::node(BaseFormula::T_EQ, op1, op2);
+}
+
+Formula createAnd(const Formula & op1, const Formula & op2)
+{
+    return NodeFactory::node(BaseFormula::T_AND, op1, op2);
+}
@@ -0,0 +1,38 @@
+#ifndef _NODEFACTORY_H
+#define _NODEFACTORY_H
+
+#include "fol.hpp"
+
+/* Tabela jedinstvenih cvorova koordinatnog jezika (hash-consing).
+   Svaki cvor se pravi samo jednom za dati tip, simbol i (vec jedinstvene)
+   podformule, pa memorija raste sa brojem razlicitih podizraza,
+   a ne sa brojem njihovih pojavljivanja.
+
+   Cvorovi zive u areni naredbe, pa se tabela prazni pozivom clear()
+   pre nego sto se arena oslobodi. Svaka nit ima svoju tabelu, kao
+   sto ima i svoju arenu. */
+class NodeFactory {
+public:
+    static Formula constant(const Rational & value);
+    static Formula coordinate(PointId point, axis a, bool negated);
+    static Formula node(BaseFormula::Type type, Formula op1,
+                        Formula op2 = nullptr);
+
+    static size_t size();
+    static void clear();
+
+private:
+    static size_t hashConst(const Rational & value);
+    static size_t hashCoordinate(PointId point, axis a, bool negated);
+    static size_t hashNode(BaseFormula::Type type, Formula op1, Formula op2);
+    static bool sameNode(Formula f, BaseFormula::Type type, Formula op1, Formula op2);
+    static Formula insert(size_t slot, Formula f);
+    static void grow();
+
+    // Otvoreno adresiranje sa linearnim probanjem; _used pamti zauzete
+    // slotove kako bi clear() bio srazmeran broju cvorova naredbe.
+    static thread_local vector<Formula> _slots;
+    static thread_local vector<size_t> _used;
+};
+
+#endif // _NODEFACTORY_H
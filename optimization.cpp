@@ -1,6 +1,22 @@
-#include <string>
 #include "optimization.h"
 
-bool optimization::optimizationIndicator;
-std::string optimization::optimizedVar;
-std::string optimization::halfOptimizedVar;
+optimizationLevel optimization::level(PointId point)
+{
+    if(optimizationIndicator && optimizedVar == NO_POINT){
+        optimizedVar = point;
+    }
+
+    if(optimizationIndicator && optimizedVar != NO_POINT &&
+            point != optimizedVar && halfOptimizedVar == NO_POINT){
+        halfOptimizedVar = point;
+    }
+
+    if(point == optimizedVar){
+        return optimized;
+    }
+    else if (point == halfOptimizedVar){
+        return halfOptimized;
+    }
+
+    return notOptimized;
+}
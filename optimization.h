@@ -1,8 +1,31 @@
-#include <string>
+#ifndef _OPTIMIZATION_H
+#define _OPTIMIZATION_H
 
+#include "symbols.hpp"
+
+enum optimizationLevel{
+    notOptimized = 0,
+    halfOptimized = 1,
+    optimized = 2
+};
+
+/* Stanje -o optimizacije jednog prevoda: prva tacka naredbe se smesta
+   u koordinatni pocetak, a druga na y osu. */
 class optimization {
 public:
-    static bool optimizationIndicator;
-    static std::string optimizedVar;
-    static std::string halfOptimizedVar;
-};
\ No newline at end of file
+    optimization(bool indicator = false)
+        :optimizationIndicator(indicator),
+          optimizedVar(NO_POINT),
+          halfOptimizedVar(NO_POINT)
+    {}
+
+    /* Nivo optimizacije tacke; prve dve razlicite tacke koje se ovde
+       jave postaju optimizovana i poluoptimizovana tacka. */
+    optimizationLevel level(PointId point);
+
+    bool optimizationIndicator;
+    PointId optimizedVar;
+    PointId halfOptimizedVar;
+};
+
+#endif // _OPTIMIZATION_H
@@ -0,0 +1,61 @@
+#include "parsecontext.hpp"
+
+#include <stdexcept>
+
+typedef void * yyscan_t;
+typedef struct yy_buffer_state * YY_BUFFER_STATE;
+
+extern int yylex_init(yyscan_t * scanner);
+extern void yyset_in(FILE * in, yyscan_t scanner);
+extern int yylex_destroy(yyscan_t scanner);
+extern YY_BUFFER_STATE yy_scan_bytes(const char * bytes, size_t length, yyscan_t scanner);
+extern YY_BUFFER_STATE yy_scan_buffer(char * base, size_t size, yyscan_t scanner);
+extern void yy_delete_buffer(YY_BUFFER_STATE buffer, yyscan_t scanner);
+
+extern int yyparse(ParseContext * ctx);
+
+ParseContext::ParseContext(FILE * in)
+    :parsedFormula(0),
+      exitIndicator(false),
+      printIndicator(false),
+      endOfInput(false),
+      scanner(0),
+      _buffer(0)
+{
+    if(yylex_init(&scanner) != 0)
+        throw runtime_error("cannot initialize scanner");
+    yyset_in(in, scanner);
+}
+
+ParseContext::~ParseContext()
+{
+    yylex_destroy(scanner);
+}
+
+void ParseContext::setInput(const char * text, size_t length)
+{
+    if(_buffer != 0)
+        yy_delete_buffer((YY_BUFFER_STATE)_buffer, scanner);
+    _buffer = yy_scan_bytes(text, length, scanner);
+    exitIndicator = false;
+    endOfInput = false;
+}
+
+void ParseContext::scanInPlace(char * text, size_t length)
+{
+    if(_buffer != 0)
+        yy_delete_buffer((YY_BUFFER_STATE)_buffer, scanner);
+    _buffer = yy_scan_buffer(text, length + 2, scanner);
+    if(_buffer == 0)
+        throw logic_error("scanInPlace: buffer is not terminated by two NULs");
+    exitIndicator = false;
+    endOfInput = false;
+}
+
+int ParseContext::parse()
+{
+    parsedFormula = 0;
+    printIndicator = false;
+    errorMessage.clear();
+    return yyparse(this);
+}
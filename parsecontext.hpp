@@ -0,0 +1,51 @@
+#ifndef _PARSECONTEXT_H
+#define _PARSECONTEXT_H
+
+#include <cstdio>
+
+#include "fol.hpp"
+
+/* Stanje parsiranja jednog ulaza: skener i rezultat poslednje naredbe.
+   Parser i skener nemaju globalno stanje, pa vise konteksta moze da
+   radi istovremeno. */
+class ParseContext {
+public:
+    ParseContext(FILE * in = stdin);
+    ~ParseContext();
+
+    /* Naredni pozivi parse() citaju naredbe iz niza text duzine length
+       umesto iz datoteke. Niz se kopira. */
+    void setInput(const char * text, size_t length);
+
+    /* Kao setInput, ali bez kopiranja: skenira se sam niz text, koji
+       iza length bajtova mora imati dva nula bajta (vidi MappedFile).
+       Skener tokom rada privremeno menja niz. */
+    void scanInPlace(char * text, size_t length);
+
+    /* Parsira sledecu naredbu ulaza. */
+    int parse();
+
+    /* Formula poslednje naredbe; vazi ako je printIndicator postavljen. */
+    Formula parsedFormula;
+    bool exitIndicator;
+    bool printIndicator;
+
+    /* exitIndicator je postavljen zato sto je ulaz procitan do kraja,
+       a ne zbog naredbe exit. */
+    bool endOfInput;
+
+    /* Poruka o gresci ako naredba nije ispravna. */
+    string errorMessage;
+
+    /* yyscan_t skenera (lexer.cpp). */
+    void * scanner;
+
+private:
+    /* YY_BUFFER_STATE niza zadatog sa setInput. */
+    void * _buffer;
+
+    ParseContext(const ParseContext &);
+    ParseContext & operator = (const ParseContext &);
+};
+
+#endif // _PARSECONTEXT_H
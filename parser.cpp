@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.4.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -33,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -40,17 +45,17 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.0.4"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
 
 /* Pure parsers.  */
-#define YYPURE 0
+#define YYPURE 2
 
 /* Push parsers.  */
 #define YYPUSH 0
@@ -61,134 +66,199 @@
 
 
 
-/* Copy the first part of user declarations.  */
-#line 2 "parser.ypp" /* yacc.c:339  */
-
-#include <stdio.h>
-
-int yylex();
-
-#define yyerror printf
-
-#include "fol.hpp"
-
-Formula parsed_formula;
-bool exitIndicator;
-bool printIndicator;
-
-#line 80 "parser.cpp" /* yacc.c:339  */
 
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
 # ifndef YY_NULLPTR
-#  if defined __cplusplus && 201103L <= __cplusplus
-#   define YY_NULLPTR nullptr
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
 #  else
-#   define YY_NULLPTR 0
+#   define YY_NULLPTR ((void*)0)
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
-
-/* In a future release of Bison, this section will be replaced
-   by #include "parser.hpp".  */
-#ifndef YY_YY_PARSER_HPP_INCLUDED
-# define YY_YY_PARSER_HPP_INCLUDED
-/* Debug traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-#if YYDEBUG
-extern int yydebug;
-#endif
-
-/* Token type.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-  enum yytokentype
-  {
-    SYMBOL = 258,
-    VARIABLE = 259,
-    EXIT = 260,
-    TRUE = 261,
-    FALSE = 262,
-    NOT = 263,
-    AND = 264,
-    OR = 265,
-    IMP = 266,
-    IFF = 267,
-    EQ = 268,
-    NEQ = 269,
-    FORALL = 270,
-    EXISTS = 271,
-    REL2 = 272,
-    REL3 = 273,
-    REL4 = 274,
-    REL5 = 275
-  };
-#endif
-
-/* Value type.  */
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-
-union YYSTYPE
+#include "parser.hpp"
+/* Symbol kind.  */
+enum yysymbol_kind_t
 {
-#line 47 "parser.ypp" /* yacc.c:355  */
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_SYMBOL = 3,                     /* SYMBOL  */
+  YYSYMBOL_VARIABLE = 4,                   /* VARIABLE  */
+  YYSYMBOL_EXIT = 5,                       /* EXIT  */
+  YYSYMBOL_TRUE = 6,                       /* TRUE  */
+  YYSYMBOL_FALSE = 7,                      /* FALSE  */
+  YYSYMBOL_NOT = 8,                        /* NOT  */
+  YYSYMBOL_AND = 9,                        /* AND  */
+  YYSYMBOL_OR = 10,                        /* OR  */
+  YYSYMBOL_IMP = 11,                       /* IMP  */
+  YYSYMBOL_IFF = 12,                       /* IFF  */
+  YYSYMBOL_EQ = 13,                        /* EQ  */
+  YYSYMBOL_NEQ = 14,                       /* NEQ  */
+  YYSYMBOL_FORALL = 15,                    /* FORALL  */
+  YYSYMBOL_EXISTS = 16,                    /* EXISTS  */
+  YYSYMBOL_REL2 = 17,                      /* REL2  */
+  YYSYMBOL_REL3 = 18,                      /* REL3  */
+  YYSYMBOL_REL4 = 19,                      /* REL4  */
+  YYSYMBOL_REL5 = 20,                      /* REL5  */
+  YYSYMBOL_21_ = 21,                       /* ';'  */
+  YYSYMBOL_22_ = 22,                       /* '['  */
+  YYSYMBOL_23_ = 23,                       /* ']'  */
+  YYSYMBOL_24_ = 24,                       /* ':'  */
+  YYSYMBOL_25_ = 25,                       /* '('  */
+  YYSYMBOL_26_ = 26,                       /* ')'  */
+  YYSYMBOL_27_ = 27,                       /* ','  */
+  YYSYMBOL_YYACCEPT = 28,                  /* $accept  */
+  YYSYMBOL_input = 29,                     /* input  */
+  YYSYMBOL_formula = 30,                   /* formula  */
+  YYSYMBOL_iff_formula = 31,               /* iff_formula  */
+  YYSYMBOL_imp_formula = 32,               /* imp_formula  */
+  YYSYMBOL_or_formula = 33,                /* or_formula  */
+  YYSYMBOL_and_formula = 34,               /* and_formula  */
+  YYSYMBOL_unary_formula = 35,             /* unary_formula  */
+  YYSYMBOL_sub_formula = 36,               /* sub_formula  */
+  YYSYMBOL_atomic_formula = 37,            /* atomic_formula  */
+  YYSYMBOL_atom = 38,                      /* atom  */
+  YYSYMBOL_term_seq = 39,                  /* term_seq  */
+  YYSYMBOL_term = 40                       /* term  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
-  string * str_attr;
-  BaseFormula * formula_attr;
-  BaseTerm * term_attr;
-  vector<Term> * term_seq_attr;
 
-#line 148 "parser.cpp" /* yacc.c:355  */
-};
 
-typedef union YYSTYPE YYSTYPE;
-# define YYSTYPE_IS_TRIVIAL 1
-# define YYSTYPE_IS_DECLARED 1
-#endif
+/* Unqualified %code blocks.  */
+#line 11 "parser.ypp"
 
+#include "parsecontext.hpp"
 
-extern YYSTYPE yylval;
+extern int scanToken(YYSTYPE * lval, void * scanner);
 
-int yyparse (void);
+static int yylex(YYSTYPE * lval, ParseContext * ctx)
+{
+    return scanToken(lval, ctx->scanner);
+}
 
-#endif /* !YY_YY_PARSER_HPP_INCLUDED  */
+static void yyerror(ParseContext * ctx, const char * msg)
+{
+    ctx->errorMessage = msg;
+}
 
-/* Copy the second part of user declarations.  */
+/* Argumenti relacija (i jednakosti) su tacke, pa slozen term kao f(a)
+   cini naredbu neispravnom u svim nacinima rada. Parsiranje se
+   nastavlja do kraja naredbe, a greska se prijavljuje umesto prevoda. */
+static void checkPoint(ParseContext * ctx, const Term & t)
+{
+    if(t->getType() == BaseTerm::TT_FUNCTION && !((FunctionTerm *)t)->getOperands().empty())
+        ctx->errorMessage = "relation arguments must be points";
+}
+
+static Atom * makeAtom(ParseContext * ctx, relation rel, const vector<Term> & ops)
+{
+    for(const Term & t : ops)
+        checkPoint(ctx, t);
+    return makeNode<Atom>(rel, ops);
+}
 
-#line 165 "parser.cpp" /* yacc.c:358  */
+#line 176 "parser.cpp"
 
 #ifdef short
 # undef short
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
-typedef unsigned char yytype_uint8;
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
 #else
 typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -196,15 +266,28 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
@@ -218,47 +301,43 @@ typedef short int yytype_int16;
 # endif
 #endif
 
-#ifndef YY_ATTRIBUTE
-# if (defined __GNUC__                                               \
-      && (2 < __GNUC__ || (__GNUC__ == 2 && 96 <= __GNUC_MINOR__)))  \
-     || defined __SUNPRO_C && 0x5110 <= __SUNPRO_C
-#  define YY_ATTRIBUTE(Spec) __attribute__(Spec)
-# else
-#  define YY_ATTRIBUTE(Spec) /* empty */
-# endif
-#endif
 
 #ifndef YY_ATTRIBUTE_PURE
-# define YY_ATTRIBUTE_PURE   YY_ATTRIBUTE ((__pure__))
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
 #endif
 
 #ifndef YY_ATTRIBUTE_UNUSED
-# define YY_ATTRIBUTE_UNUSED YY_ATTRIBUTE ((__unused__))
-#endif
-
-#if !defined _Noreturn \
-     && (!defined __STDC_VERSION__ || __STDC_VERSION__ < 201112)
-# if defined _MSC_VER && 1200 <= _MSC_VER
-#  define _Noreturn __declspec (noreturn)
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
 # else
-#  define _Noreturn YY_ATTRIBUTE ((__noreturn__))
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN \
-    _Pragma ("GCC diagnostic push") \
-    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")\
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END \
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
 # define YY_INITIAL_VALUE(Value) Value
@@ -271,8 +350,22 @@ typedef short int yytype_int16;
 # define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#if !defined yyoverflow
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -337,8 +430,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -347,17 +439,17 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
 # define YYCOPY_NEEDED 1
@@ -370,11 +462,11 @@ union yyalloc
 # define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
     do                                                                  \
       {                                                                 \
-        YYSIZE_T yynewbytes;                                            \
+        YYPTRDIFF_T yynewbytes;                                         \
         YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
         Stack = &yyptr->Stack_alloc;                                    \
-        yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-        yyptr += yynewbytes / sizeof (*yyptr);                          \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
       }                                                                 \
     while (0)
 
@@ -386,12 +478,12 @@ union yyalloc
 # ifndef YYCOPY
 #  if defined __GNUC__ && 1 < __GNUC__
 #   define YYCOPY(Dst, Src, Count) \
-      __builtin_memcpy (Dst, Src, (Count) * sizeof (*(Src)))
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
 #  else
 #   define YYCOPY(Dst, Src, Count)              \
       do                                        \
         {                                       \
-          YYSIZE_T yyi;                         \
+          YYPTRDIFF_T yyi;                      \
           for (yyi = 0; yyi < (Count); yyi++)   \
             (Dst)[yyi] = (Src)[yyi];            \
         }                                       \
@@ -403,28 +495,31 @@ union yyalloc
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  35
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   94
+#define YYLAST   138
 
 /* YYNTOKENS -- Number of terminals.  */
 #define YYNTOKENS  28
 /* YYNNTS -- Number of nonterminals.  */
 #define YYNNTS  13
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  32
+#define YYNRULES  33
 /* YYNSTATES -- Number of states.  */
 #define YYNSTATES  91
 
-/* YYTRANSLATE[YYX] -- Symbol number corresponding to YYX as returned
-   by yylex, with out-of-bounds checking.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   275
 
-#define YYTRANSLATE(YYX)                                                \
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
-   as returned by yylex, without out-of-bounds checking.  */
-static const yytype_uint8 yytranslate[] =
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -457,132 +552,142 @@ static const yytype_uint8 yytranslate[] =
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
-static const yytype_uint8 yyrline[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,    56,    56,    62,    69,    75,    79,    85,    89,    95,
-      99,   105,   109,   115,   119,   124,   129,   135,   139,   145,
-     149,   153,   166,   178,   182,   186,   190,   194,   200,   205,
-     212,   217,   222
+       0,    86,    86,    92,    97,   105,   111,   115,   121,   125,
+     131,   135,   141,   145,   151,   155,   159,   163,   169,   173,
+     179,   183,   187,   200,   212,   216,   220,   224,   230,   238,
+     243,   250,   254,   258
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 0
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "SYMBOL", "VARIABLE", "EXIT", "TRUE",
-  "FALSE", "NOT", "AND", "OR", "IMP", "IFF", "EQ", "NEQ", "FORALL",
-  "EXISTS", "REL2", "REL3", "REL4", "REL5", "';'", "'['", "']'", "':'",
-  "'('", "')'", "','", "$accept", "input", "formula", "iff_formula",
+  "\"end of file\"", "error", "\"invalid token\"", "SYMBOL", "VARIABLE",
+  "EXIT", "TRUE", "FALSE", "NOT", "AND", "OR", "IMP", "IFF", "EQ", "NEQ",
+  "FORALL", "EXISTS", "REL2", "REL3", "REL4", "REL5", "';'", "'['", "']'",
+  "':'", "'('", "')'", "','", "$accept", "input", "formula", "iff_formula",
   "imp_formula", "or_formula", "and_formula", "unary_formula",
   "sub_formula", "atomic_formula", "atom", "term_seq", "term", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,    59,    91,    93,    58,    40,    41,    44
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-#define YYPACT_NINF -26
+#define YYPACT_NINF (-26)
 
-#define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-26)))
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF -1
+#define YYTABLE_NINF (-33)
 
-#define yytable_value_is_error(Yytable_value) \
+#define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int8 yypact[] =
 {
-       7,    -5,   -26,     8,   -26,   -26,    58,    -1,     6,     5,
-      10,    11,    16,    58,    31,    12,    30,    33,    35,    37,
-     -26,   -26,   -26,   -26,   -12,     0,   -26,   -26,    43,    44,
-       0,     0,     0,     0,    23,   -26,   -26,    58,    58,    58,
-      58,     0,     0,    -8,   -26,    27,    32,    29,    40,    41,
-      42,   -26,    33,    35,    37,   -26,   -26,   -26,   -26,     0,
-      36,    48,     0,     0,     0,     0,   -26,    58,    58,    28,
-      52,    53,    54,   -26,   -26,   -26,     0,     0,     0,    56,
-      57,    59,   -26,     0,     0,    61,    62,   -26,     0,    64,
+      61,    78,   -26,    -9,   -26,   -26,     7,    11,    14,     6,
+      17,    19,    24,     7,    54,    35,    29,    89,    72,     9,
+     -26,   -26,   -26,   -26,   -12,     0,   -26,   -26,    56,    68,
+       0,     0,     0,     0,    47,   -26,   -26,     7,     7,     7,
+       7,     0,     0,     2,   -26,    51,    52,    58,    67,    75,
+      82,   -26,    96,    85,    36,   -26,   -26,   -26,   -26,     0,
+      88,    90,     0,     0,     0,     0,   -26,     7,     7,    87,
+      91,    92,    93,   -26,   -26,   -26,     0,     0,     0,    95,
+      97,    98,   -26,     0,     0,   100,   101,   -26,     0,   103,
      -26
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
-static const yytype_uint8 yydefact[] =
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
 {
-       0,    31,    30,     0,    20,    21,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     4,     6,     8,    10,
-      12,    16,    17,    19,     0,     0,     3,    13,     0,     0,
+       0,     0,    31,     0,    21,    22,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+      13,    17,    18,    20,     0,     0,     3,    14,     0,     0,
        0,     0,     0,     0,     0,     1,     2,     0,     0,     0,
-       0,     0,     0,     0,    29,     0,     0,     0,     0,     0,
-       0,    18,     5,     7,     9,    11,    26,    27,    32,     0,
-       0,     0,     0,     0,     0,     0,    28,     0,     0,     0,
-       0,     0,     0,    14,    15,    22,     0,     0,     0,     0,
-       0,     0,    23,     0,     0,     0,     0,    24,     0,     0,
-      25
+       0,     0,     0,     0,    30,     0,     0,     0,     0,     0,
+       0,    19,     0,     0,     0,    12,    27,    28,    33,     0,
+       0,     0,     0,     0,     0,     0,    29,     0,     0,     0,
+       0,     0,     0,    15,    16,    23,     0,     0,     0,     0,
+       0,     0,    24,     0,     0,     0,     0,    25,     0,     0,
+      26
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
-     -26,   -26,    72,   -26,    20,    50,    55,     3,   -26,   -26,
+     -26,   -26,   110,   -26,    79,    94,    99,     3,   -26,   -26,
      -26,   -26,   -25
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
+/* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int8 yydefgoto[] =
 {
-      -1,    14,    15,    16,    17,    18,    19,    20,    21,    22,
+       0,    14,    15,    16,    17,    18,    19,    20,    21,    22,
       23,    43,    24
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
-static const yytype_uint8 yytable[] =
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int8 yytable[] =
 {
       44,    41,    42,     1,     2,    47,    48,    49,    50,    27,
-       1,     2,     3,     4,     5,     6,    56,    57,    58,    59,
-      25,    28,     7,     8,     9,    10,    11,    12,    29,    26,
-      30,    35,    13,    36,    66,    31,    32,    69,    70,    71,
-      72,    33,    37,    55,    38,    39,    40,    45,    46,    51,
-      60,    79,    80,    81,    75,    61,    62,    52,    85,    86,
-      67,     1,     2,    89,     4,     5,     6,    63,    64,    65,
-      73,    74,    68,     7,     8,     9,    10,    11,    12,    76,
-      77,    78,    82,    13,    83,    34,    84,    87,    53,    88,
-      90,     0,     0,     0,    54
+       1,     2,    26,     4,     5,     6,    56,    57,    40,   -11,
+     -11,   -11,     7,     8,     9,    10,    11,    12,    58,    59,
+     -11,    30,    13,    28,    66,   -11,    29,    69,    70,    71,
+      72,    37,    31,    55,    32,    40,   -10,   -10,   -10,    33,
+      -5,    79,    80,    81,    35,    -5,    36,   -10,    85,    86,
+      45,    -4,   -10,    89,     1,     2,     3,     4,     5,     6,
+      73,    74,    46,    51,    60,    61,     7,     8,     9,    10,
+      11,    12,    39,    -9,    -9,    62,    13,   -32,   -32,   -32,
+     -32,   -32,   -32,    -9,    63,    39,    -8,    -8,    -9,   -32,
+      38,    -7,    64,    25,   -32,   -32,    -8,    38,    -6,    65,
+      -7,    -8,    67,    75,    68,    -7,    52,    -6,    76,    77,
+      78,    82,    -6,    34,    83,    84,    87,     0,    88,    90,
+       0,     0,    53,     0,     0,     0,     0,     0,    54
 };
 
 static const yytype_int8 yycheck[] =
 {
       25,    13,    14,     3,     4,    30,    31,    32,    33,     6,
-       3,     4,     5,     6,     7,     8,    41,    42,    26,    27,
-      25,    22,    15,    16,    17,    18,    19,    20,    22,    21,
-      25,     0,    25,    21,    59,    25,    25,    62,    63,    64,
-      65,    25,    12,    40,    11,    10,     9,     4,     4,    26,
-      23,    76,    77,    78,    26,    23,    27,    37,    83,    84,
-      24,     3,     4,    88,     6,     7,     8,    27,    27,    27,
-      67,    68,    24,    15,    16,    17,    18,    19,    20,    27,
-      27,    27,    26,    25,    27,    13,    27,    26,    38,    27,
-      26,    -1,    -1,    -1,    39
+       3,     4,    21,     6,     7,     8,    41,    42,     9,    10,
+      11,    12,    15,    16,    17,    18,    19,    20,    26,    27,
+      21,    25,    25,    22,    59,    26,    22,    62,    63,    64,
+      65,    12,    25,    40,    25,     9,    10,    11,    12,    25,
+      21,    76,    77,    78,     0,    26,    21,    21,    83,    84,
+       4,     0,    26,    88,     3,     4,     5,     6,     7,     8,
+      67,    68,     4,    26,    23,    23,    15,    16,    17,    18,
+      19,    20,    10,    11,    12,    27,    25,     9,    10,    11,
+      12,    13,    14,    21,    27,    10,    11,    12,    26,    21,
+      11,    12,    27,    25,    26,    27,    21,    11,    12,    27,
+      21,    26,    24,    26,    24,    26,    37,    21,    27,    27,
+      27,    26,    26,    13,    27,    27,    26,    -1,    27,    26,
+      -1,    -1,    38,    -1,    -1,    -1,    -1,    -1,    39
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
        0,     3,     4,     5,     6,     7,     8,    15,    16,    17,
       18,    19,    20,    25,    29,    30,    31,    32,    33,    34,
@@ -596,58 +701,58 @@ static const yytype_uint8 yystos[] =
       26
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
 {
-       0,    28,    29,    29,    30,    31,    31,    32,    32,    33,
-      33,    34,    34,    35,    35,    35,    35,    36,    36,    37,
-      37,    37,    38,    38,    38,    38,    38,    38,    39,    39,
-      40,    40,    40
+       0,    28,    29,    29,    29,    30,    31,    31,    32,    32,
+      33,    33,    34,    34,    35,    35,    35,    35,    36,    36,
+      37,    37,    37,    38,    38,    38,    38,    38,    38,    39,
+      39,    40,    40,    40
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
 {
-       0,     2,     2,     2,     1,     3,     1,     3,     1,     3,
-       1,     3,     1,     2,     6,     6,     1,     1,     3,     1,
-       1,     1,     6,     8,    10,    12,     3,     3,     3,     1,
-       1,     1,     4
+       0,     2,     2,     2,     0,     1,     3,     1,     3,     1,
+       3,     1,     3,     1,     2,     6,     6,     1,     1,     3,
+       1,     1,     1,     6,     8,    10,    12,     3,     3,     3,
+       1,     1,     1,     4
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)                                  \
-do                                                              \
-  if (yychar == YYEMPTY)                                        \
-    {                                                           \
-      yychar = (Token);                                         \
-      yylval = (Value);                                         \
-      YYPOPSTACK (yylen);                                       \
-      yystate = *yyssp;                                         \
-      goto yybackup;                                            \
-    }                                                           \
-  else                                                          \
-    {                                                           \
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;                                                  \
-    }                                                           \
-while (0)
-
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (ctx, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 
 /* Enable debugging if requested.  */
@@ -664,55 +769,53 @@ do {                                            \
     YYFPRINTF Args;                             \
 } while (0)
 
-/* This macro is provided for backward compatibility. */
-#ifndef YY_LOCATION_PRINT
-# define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-#endif
 
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value); \
+                  Kind, Value, ctx); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
 
 
-/*----------------------------------------.
-| Print this symbol's value on YYOUTPUT.  |
-`----------------------------------------*/
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, ParseContext * ctx)
 {
-  FILE *yyo = yyoutput;
-  YYUSE (yyo);
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (ctx);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# endif
-  YYUSE (yytype);
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, ParseContext * ctx)
 {
-  YYFPRINTF (yyoutput, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep);
-  YYFPRINTF (yyoutput, ")");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, ctx);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -721,7 +824,7 @@ yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
 `------------------------------------------------------------------*/
 
 static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -744,21 +847,21 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, int yyrule)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, ParseContext * ctx)
 {
-  unsigned long int yylno = yyrline[yyrule];
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
              yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[yyssp[yyi + 1 - yynrhs]],
-                       &(yyvsp[(yyi + 1) - (yynrhs)])
-                                              );
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], ctx);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -766,15 +869,15 @@ yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, int yyrule)
 # define YY_REDUCE_PRINT(Rule)          \
 do {                                    \
   if (yydebug)                          \
-    yy_reduce_print (yyssp, yyvsp, Rule); \
+    yy_reduce_print (yyssp, yyvsp, Rule, ctx); \
 } while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
@@ -797,255 +900,42 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-static YYSIZE_T
-yystrlen (const char *yystr)
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
-
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
-
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
-
-  return yyd - 1;
-}
-#  endif
-# endif
-
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-        switch (*++yyp)
-          {
-          case '\'':
-          case ',':
-            goto do_not_strip_quotes;
-
-          case '\\':
-            if (*++yyp != '\\')
-              goto do_not_strip_quotes;
-            /* Fall through.  */
-          default:
-            if (yyres)
-              yyres[yyn] = *yyp;
-            yyn++;
-            break;
-
-          case '"':
-            if (yyres)
-              yyres[yyn] = '\0';
-            return yyn;
-          }
-    do_not_strip_quotes: ;
-    }
-
-  if (! yyres)
-    return yystrlen (yystr);
-
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
 
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
-
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
-static int
-yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
-                yytype_int16 *yyssp, int yytoken)
-{
-  YYSIZE_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat. */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Number of reported tokens (one for the "unexpected", one per
-     "expected"). */
-  int yycount = 0;
-
-  /* There are many possibilities here to consider:
-     - If this state is a consistent state with a default action, then
-       the only way this function was invoked is if the default action
-       is an error action.  In that case, don't check for expected
-       tokens because there are none.
-     - The only way there can be no lookahead present (in yychar) is if
-       this state is a consistent state with a default action.  Thus,
-       detecting the absence of a lookahead is sufficient to determine
-       that there is no unexpected or expected token to report.  In that
-       case, just report a simple "syntax error".
-     - Don't assume there isn't a lookahead just because this state is a
-       consistent state with a default action.  There might have been a
-       previous inconsistent state, consistent state with a non-default
-       action, or user semantic action that manipulated yychar.
-     - Of course, the expected token list depends on states to have
-       correct lookahead information, and it depends on the parser not
-       to perform extra reductions after fetching a lookahead from the
-       scanner and before detecting a syntax error.  Thus, state merging
-       (from LALR or IELR) and default reductions corrupt the expected
-       token list.  However, the list is correct for canonical LR with
-       one exception: it will still contain any token that will not be
-       accepted due to an error action in a later state.
-  */
-  if (yytoken != YYEMPTY)
-    {
-      int yyn = yypact[*yyssp];
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYSIZE_T yysize1 = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (! (yysize <= yysize1
-                         && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-                    return 2;
-                  yysize = yysize1;
-                }
-              }
-        }
-    }
 
-  switch (yycount)
-    {
-# define YYCASE_(N, S)                      \
-      case N:                               \
-        yyformat = S;                       \
-      break
-      YYCASE_(0, YY_("syntax error"));
-      YYCASE_(1, YY_("syntax error, unexpected %s"));
-      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
-      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
-      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
-      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
-    }
-
-  {
-    YYSIZE_T yysize1 = yysize + yystrlen (yyformat);
-    if (! (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-      return 2;
-    yysize = yysize1;
-  }
-
-  if (*yymsg_alloc < yysize)
-    {
-      *yymsg_alloc = 2 * yysize;
-      if (! (yysize <= *yymsg_alloc
-             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
-        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
-    }
-
-  /* Avoid sprintf, as that infringes on the user's name space.
-     Don't have undefined behavior even if the translation
-     produced a string with the wrong number of "%s"s.  */
-  {
-    char *yyp = *yymsg;
-    int yyi = 0;
-    while ((*yyp = *yyformat) != '\0')
-      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
-        {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
-          yyformat += 2;
-        }
-      else
-        {
-          yyp++;
-          yyformat++;
-        }
-  }
-  return 0;
-}
-#endif /* YYERROR_VERBOSE */
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, ParseContext * ctx)
 {
-  YYUSE (yyvaluep);
+  YY_USE (yyvaluep);
+  YY_USE (ctx);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  switch (yykind)
+    {
+    case YYSYMBOL_term_seq: /* term_seq  */
+#line 74 "parser.ypp"
+            { delete ((*yyvaluep).term_seq_attr); }
+#line 928 "parser.cpp"
+        break;
+
+      default:
+        break;
+    }
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
 
 
-/* The lookahead symbol.  */
-int yychar;
-
-/* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval;
-/* Number of syntax errors so far.  */
-int yynerrs;
 
 
 /*----------.
@@ -1053,45 +943,51 @@ int yynerrs;
 `----------*/
 
 int
-yyparse (void)
+yyparse (ParseContext * ctx)
 {
-    int yystate;
-    /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+/* Lookahead token kind.  */
+int yychar;
+
+
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
 
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
 
-       Refer to the stacks through separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-    /* The semantic value stack.  */
-    YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    YYSIZE_T yystacksize;
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
 
@@ -1099,71 +995,75 @@ yyparse (void)
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
         /* Give user a chance to reallocate the stack.  Use copies of
            these so that the &'s don't force the real ones into
            memory.  */
+        yy_state_t *yyss1 = yyss;
         YYSTYPE *yyvs1 = yyvs;
-        yytype_int16 *yyss1 = yyss;
 
         /* Each stack pointer address is followed by the size of the
            data in use in that stack, in bytes.  This used to be a
            conditional around just the two extra args, but that might
            be undefined if yyoverflow is a macro.  */
         yyoverflow (YY_("memory exhausted"),
-                    &yyss1, yysize * sizeof (*yyssp),
-                    &yyvs1, yysize * sizeof (*yyvsp),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
                     &yystacksize);
-
         yyss = yyss1;
         yyvs = yyvs1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
 
       {
-        yytype_int16 *yyss1 = yyss;
+        yy_state_t *yyss1 = yyss;
         union yyalloc *yyptr =
-          (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
@@ -1171,30 +1071,31 @@ yyparse (void)
           YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-                  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
         YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
@@ -1205,18 +1106,29 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = yylex ();
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, ctx);
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1244,15 +1156,13 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1267,7 +1177,7 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
@@ -1287,267 +1197,277 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-#line 57 "parser.ypp" /* yacc.c:1646  */
-    {
-         parsed_formula = Formula((yyvsp[-1].formula_attr));
-         printIndicator = true;
+  case 2: /* input: formula ';'  */
+#line 87 "parser.ypp"
+       {
+         ctx->parsedFormula = (yyvsp[-1].formula_attr);
+         ctx->printIndicator = ctx->errorMessage.empty();
 	     return 0;
        }
-#line 1298 "parser.cpp" /* yacc.c:1646  */
+#line 1208 "parser.cpp"
     break;
 
-  case 3:
-#line 63 "parser.ypp" /* yacc.c:1646  */
-    {
-        exitIndicator = true;
+  case 3: /* input: EXIT ';'  */
+#line 93 "parser.ypp"
+       {
+        ctx->exitIndicator = true;
         return 0;
        }
-#line 1307 "parser.cpp" /* yacc.c:1646  */
+#line 1217 "parser.cpp"
     break;
 
-  case 4:
-#line 70 "parser.ypp" /* yacc.c:1646  */
-    {
+  case 4: /* input: %empty  */
+#line 98 "parser.ypp"
+       {
+        ctx->exitIndicator = true;
+        ctx->endOfInput = true;
+        return 0;
+       }
+#line 1227 "parser.cpp"
+    break;
+
+  case 5: /* formula: iff_formula  */
+#line 106 "parser.ypp"
+        {
 	 (yyval.formula_attr) = (yyvsp[0].formula_attr);
 	}
-#line 1315 "parser.cpp" /* yacc.c:1646  */
+#line 1235 "parser.cpp"
     break;
 
-  case 5:
-#line 76 "parser.ypp" /* yacc.c:1646  */
-    {
-	  (yyval.formula_attr) = new Iff(Formula((yyvsp[-2].formula_attr)), Formula((yyvsp[0].formula_attr)));
+  case 6: /* iff_formula: iff_formula IFF imp_formula  */
+#line 112 "parser.ypp"
+        {
+	  (yyval.formula_attr) = makeNode<Iff>((yyvsp[-2].formula_attr), (yyvsp[0].formula_attr));
 	}
-#line 1323 "parser.cpp" /* yacc.c:1646  */
+#line 1243 "parser.cpp"
     break;
 
-  case 6:
-#line 80 "parser.ypp" /* yacc.c:1646  */
-    {
+  case 7: /* iff_formula: imp_formula  */
+#line 116 "parser.ypp"
+        {
 	  (yyval.formula_attr) = (yyvsp[0].formula_attr);
 	}
-#line 1331 "parser.cpp" /* yacc.c:1646  */
+#line 1251 "parser.cpp"
     break;
 
-  case 7:
-#line 86 "parser.ypp" /* yacc.c:1646  */
-    {
-	      (yyval.formula_attr) = new Imp(Formula((yyvsp[-2].formula_attr)), Formula((yyvsp[0].formula_attr)));
+  case 8: /* imp_formula: imp_formula IMP or_formula  */
+#line 122 "parser.ypp"
+            {
+	      (yyval.formula_attr) = makeNode<Imp>((yyvsp[-2].formula_attr), (yyvsp[0].formula_attr));
 	    }
-#line 1339 "parser.cpp" /* yacc.c:1646  */
+#line 1259 "parser.cpp"
     break;
 
-  case 8:
-#line 90 "parser.ypp" /* yacc.c:1646  */
-    {
+  case 9: /* imp_formula: or_formula  */
+#line 126 "parser.ypp"
+            {
 	      (yyval.formula_attr) = (yyvsp[0].formula_attr);
 	    }
-#line 1347 "parser.cpp" /* yacc.c:1646  */
+#line 1267 "parser.cpp"
     break;
 
-  case 9:
-#line 96 "parser.ypp" /* yacc.c:1646  */
-    {
-	     (yyval.formula_attr) = new Or(Formula((yyvsp[-2].formula_attr)), Formula((yyvsp[0].formula_attr)));
+  case 10: /* or_formula: or_formula OR and_formula  */
+#line 132 "parser.ypp"
+           {
+	     (yyval.formula_attr) = makeNode<Or>((yyvsp[-2].formula_attr), (yyvsp[0].formula_attr));
 	   }
-#line 1355 "parser.cpp" /* yacc.c:1646  */
+#line 1275 "parser.cpp"
     break;
 
-  case 10:
-#line 100 "parser.ypp" /* yacc.c:1646  */
-    {
+  case 11: /* or_formula: and_formula  */
+#line 136 "parser.ypp"
+           {
 	     (yyval.formula_attr) = (yyvsp[0].formula_attr);
 	   }
-#line 1363 "parser.cpp" /* yacc.c:1646  */
+#line 1283 "parser.cpp"
     break;
 
-  case 11:
-#line 106 "parser.ypp" /* yacc.c:1646  */
-    {
-	      (yyval.formula_attr) = new And(Formula((yyvsp[-2].formula_attr)), Formula((yyvsp[0].formula_attr)));
+  case 12: /* and_formula: and_formula AND unary_formula  */
+#line 142 "parser.ypp"
+            {
+	      (yyval.formula_attr) = makeNode<And>((yyvsp[-2].formula_attr), (yyvsp[0].formula_attr));
 	    }
-#line 1371 "parser.cpp" /* yacc.c:1646  */
+#line 1291 "parser.cpp"
     break;
 
-  case 12:
-#line 110 "parser.ypp" /* yacc.c:1646  */
-    {
+  case 13: /* and_formula: unary_formula  */
+#line 146 "parser.ypp"
+            {
 	      (yyval.formula_attr) = (yyvsp[0].formula_attr);
 	    }
-#line 1379 "parser.cpp" /* yacc.c:1646  */
+#line 1299 "parser.cpp"
     break;
 
-  case 13:
-#line 116 "parser.ypp" /* yacc.c:1646  */
-    {
-	       (yyval.formula_attr) = new Not(Formula((yyvsp[0].formula_attr)));
+  case 14: /* unary_formula: NOT unary_formula  */
+#line 152 "parser.ypp"
+              {
+	       (yyval.formula_attr) = makeNode<Not>((yyvsp[0].formula_attr));
 	      }
-#line 1387 "parser.cpp" /* yacc.c:1646  */
+#line 1307 "parser.cpp"
     break;
 
-  case 14:
-#line 120 "parser.ypp" /* yacc.c:1646  */
-    {
-	       (yyval.formula_attr) = new Forall(*(yyvsp[-3].str_attr), Formula((yyvsp[0].formula_attr)));
-	       delete (yyvsp[-3].str_attr);
+  case 15: /* unary_formula: FORALL '[' VARIABLE ']' ':' unary_formula  */
+#line 156 "parser.ypp"
+              {
+	       (yyval.formula_attr) = makeNode<Forall>((yyvsp[-3].name_attr), (yyvsp[0].formula_attr));
 	      }
-#line 1396 "parser.cpp" /* yacc.c:1646  */
+#line 1315 "parser.cpp"
     break;
 
-  case 15:
-#line 125 "parser.ypp" /* yacc.c:1646  */
-    {
-	       (yyval.formula_attr) = new Exists(*(yyvsp[-3].str_attr), Formula((yyvsp[0].formula_attr)));
-	       delete (yyvsp[-3].str_attr);
+  case 16: /* unary_formula: EXISTS '[' VARIABLE ']' ':' unary_formula  */
+#line 160 "parser.ypp"
+              {
+	       (yyval.formula_attr) = makeNode<Exists>((yyvsp[-3].name_attr), (yyvsp[0].formula_attr));
 	      }
-#line 1405 "parser.cpp" /* yacc.c:1646  */
+#line 1323 "parser.cpp"
     break;
 
-  case 16:
-#line 130 "parser.ypp" /* yacc.c:1646  */
-    {
+  case 17: /* unary_formula: sub_formula  */
+#line 164 "parser.ypp"
+              {
 	       (yyval.formula_attr) = (yyvsp[0].formula_attr);
 	      }
-#line 1413 "parser.cpp" /* yacc.c:1646  */
+#line 1331 "parser.cpp"
     break;
 
-  case 17:
-#line 136 "parser.ypp" /* yacc.c:1646  */
-    {
+  case 18: /* sub_formula: atomic_formula  */
+#line 170 "parser.ypp"
+            {
 	      (yyval.formula_attr) = (yyvsp[0].formula_attr);
 	    }
-#line 1421 "parser.cpp" /* yacc.c:1646  */
+#line 1339 "parser.cpp"
     break;
 
-  case 18:
-#line 140 "parser.ypp" /* yacc.c:1646  */
-    {
+  case 19: /* sub_formula: '(' formula ')'  */
+#line 174 "parser.ypp"
+            {
 	      (yyval.formula_attr) = (yyvsp[-1].formula_attr);
 	    }
-#line 1429 "parser.cpp" /* yacc.c:1646  */
+#line 1347 "parser.cpp"
     break;
 
-  case 19:
-#line 146 "parser.ypp" /* yacc.c:1646  */
-    {
+  case 20: /* atomic_formula: atom  */
+#line 180 "parser.ypp"
+               {
 	         (yyval.formula_attr) = (yyvsp[0].formula_attr);
 	       }
-#line 1437 "parser.cpp" /* yacc.c:1646  */
+#line 1355 "parser.cpp"
     break;
 
-  case 20:
-#line 150 "parser.ypp" /* yacc.c:1646  */
-    {
-	         (yyval.formula_attr) = new True();
+  case 21: /* atomic_formula: TRUE  */
+#line 184 "parser.ypp"
+               {
+	         (yyval.formula_attr) = makeNode<True>();
 	       }
-#line 1445 "parser.cpp" /* yacc.c:1646  */
+#line 1363 "parser.cpp"
     break;
 
-  case 21:
-#line 154 "parser.ypp" /* yacc.c:1646  */
-    {
-	         (yyval.formula_attr) = new False();
+  case 22: /* atomic_formula: FALSE  */
+#line 188 "parser.ypp"
+               {
+	         (yyval.formula_attr) = makeNode<False>();
 	       }
-#line 1453 "parser.cpp" /* yacc.c:1646  */
+#line 1371 "parser.cpp"
     break;
 
-  case 22:
-#line 167 "parser.ypp" /* yacc.c:1646  */
-    {
-       (yyval.formula_attr) = new Atom(*(yyvsp[-5].str_attr), *new vector<Term>{ Term((yyvsp[-3].term_attr)), Term((yyvsp[-1].term_attr)) } );
+  case 23: /* atom: REL2 '(' term ',' term ')'  */
+#line 201 "parser.ypp"
+     {
+       (yyval.formula_attr) = makeAtom(ctx, (yyvsp[-5].rel_attr), vector<Term>{ (yyvsp[-3].term_attr), (yyvsp[-1].term_attr) });
      }
-#line 1461 "parser.cpp" /* yacc.c:1646  */
+#line 1379 "parser.cpp"
     break;
 
-  case 23:
-#line 179 "parser.ypp" /* yacc.c:1646  */
-    {
-       (yyval.formula_attr) = new Atom(*(yyvsp[-7].str_attr), *new vector<Term>{ Term((yyvsp[-5].term_attr)), Term((yyvsp[-3].term_attr)), Term((yyvsp[-1].term_attr)) } );
+  case 24: /* atom: REL3 '(' term ',' term ',' term ')'  */
+#line 213 "parser.ypp"
+     {
+       (yyval.formula_attr) = makeAtom(ctx, (yyvsp[-7].rel_attr), vector<Term>{ (yyvsp[-5].term_attr), (yyvsp[-3].term_attr), (yyvsp[-1].term_attr) });
      }
-#line 1469 "parser.cpp" /* yacc.c:1646  */
+#line 1387 "parser.cpp"
     break;
 
-  case 24:
-#line 183 "parser.ypp" /* yacc.c:1646  */
-    {
-       (yyval.formula_attr) = new Atom(*(yyvsp[-9].str_attr), *new vector<Term>{ Term((yyvsp[-7].term_attr)), Term((yyvsp[-5].term_attr)), Term((yyvsp[-3].term_attr)), Term((yyvsp[-1].term_attr)) } );
+  case 25: /* atom: REL4 '(' term ',' term ',' term ',' term ')'  */
+#line 217 "parser.ypp"
+     {
+       (yyval.formula_attr) = makeAtom(ctx, (yyvsp[-9].rel_attr), vector<Term>{ (yyvsp[-7].term_attr), (yyvsp[-5].term_attr), (yyvsp[-3].term_attr), (yyvsp[-1].term_attr) });
      }
-#line 1477 "parser.cpp" /* yacc.c:1646  */
+#line 1395 "parser.cpp"
     break;
 
-  case 25:
-#line 187 "parser.ypp" /* yacc.c:1646  */
-    {
-       (yyval.formula_attr) = new Atom(*(yyvsp[-11].str_attr), *new vector<Term>{ Term((yyvsp[-9].term_attr)), Term((yyvsp[-7].term_attr)), Term((yyvsp[-5].term_attr)), Term((yyvsp[-3].term_attr)), Term((yyvsp[-1].term_attr)) } );
+  case 26: /* atom: REL5 '(' term ',' term ',' term ',' term ',' term ')'  */
+#line 221 "parser.ypp"
+     {
+       (yyval.formula_attr) = makeAtom(ctx, (yyvsp[-11].rel_attr), vector<Term>{ (yyvsp[-9].term_attr), (yyvsp[-7].term_attr), (yyvsp[-5].term_attr), (yyvsp[-3].term_attr), (yyvsp[-1].term_attr) });
      }
-#line 1485 "parser.cpp" /* yacc.c:1646  */
+#line 1403 "parser.cpp"
     break;
 
-  case 26:
-#line 191 "parser.ypp" /* yacc.c:1646  */
-    {
-       (yyval.formula_attr) = new Equality(Term((yyvsp[-2].term_attr)), Term((yyvsp[0].term_attr)));
+  case 27: /* atom: term EQ term  */
+#line 225 "parser.ypp"
+     {
+       checkPoint(ctx, (yyvsp[-2].term_attr));
+       checkPoint(ctx, (yyvsp[0].term_attr));
+       (yyval.formula_attr) = makeNode<Equality>((yyvsp[-2].term_attr), (yyvsp[0].term_attr));
      }
-#line 1493 "parser.cpp" /* yacc.c:1646  */
+#line 1413 "parser.cpp"
     break;
 
-  case 27:
-#line 195 "parser.ypp" /* yacc.c:1646  */
-    {
-       (yyval.formula_attr) = new Disequality(Term((yyvsp[-2].term_attr)), Term((yyvsp[0].term_attr)));
+  case 28: /* atom: term NEQ term  */
+#line 231 "parser.ypp"
+     {
+       checkPoint(ctx, (yyvsp[-2].term_attr));
+       checkPoint(ctx, (yyvsp[0].term_attr));
+       (yyval.formula_attr) = makeNode<Disequality>((yyvsp[-2].term_attr), (yyvsp[0].term_attr));
      }
-#line 1501 "parser.cpp" /* yacc.c:1646  */
+#line 1423 "parser.cpp"
     break;
 
-  case 28:
-#line 201 "parser.ypp" /* yacc.c:1646  */
-    {
+  case 29: /* term_seq: term_seq ',' term  */
+#line 239 "parser.ypp"
+         {
 	   (yyval.term_seq_attr) = (yyvsp[-2].term_seq_attr);
-	   (yyval.term_seq_attr)->push_back(Term((yyvsp[0].term_attr)));
+	   (yyval.term_seq_attr)->push_back((yyvsp[0].term_attr));
 	 }
-#line 1510 "parser.cpp" /* yacc.c:1646  */
+#line 1432 "parser.cpp"
     break;
 
-  case 29:
-#line 206 "parser.ypp" /* yacc.c:1646  */
-    {
+  case 30: /* term_seq: term  */
+#line 244 "parser.ypp"
+         {
 	   (yyval.term_seq_attr) = new vector<Term>();
-	   (yyval.term_seq_attr)->push_back(Term((yyvsp[0].term_attr)));
+	   (yyval.term_seq_attr)->push_back((yyvsp[0].term_attr));
 	 }
-#line 1519 "parser.cpp" /* yacc.c:1646  */
+#line 1441 "parser.cpp"
     break;
 
-  case 30:
-#line 213 "parser.ypp" /* yacc.c:1646  */
-    {
-       (yyval.term_attr) = new VariableTerm(*(yyvsp[0].str_attr));
-       delete (yyvsp[0].str_attr);
+  case 31: /* term: VARIABLE  */
+#line 251 "parser.ypp"
+     {
+       (yyval.term_attr) = makeNode<VariableTerm>((yyvsp[0].name_attr));
      }
-#line 1528 "parser.cpp" /* yacc.c:1646  */
+#line 1449 "parser.cpp"
     break;
 
-  case 31:
-#line 218 "parser.ypp" /* yacc.c:1646  */
-    {
-       (yyval.term_attr) = new FunctionTerm(*(yyvsp[0].str_attr));
-       delete (yyvsp[0].str_attr);
+  case 32: /* term: SYMBOL  */
+#line 255 "parser.ypp"
+     {
+       (yyval.term_attr) = makeNode<FunctionTerm>((yyvsp[0].name_attr));
      }
-#line 1537 "parser.cpp" /* yacc.c:1646  */
+#line 1457 "parser.cpp"
     break;
 
-  case 32:
-#line 223 "parser.ypp" /* yacc.c:1646  */
-    {
-       (yyval.term_attr) = new FunctionTerm(*(yyvsp[-3].str_attr), *(yyvsp[-1].term_seq_attr));
-       delete (yyvsp[-3].str_attr);
+  case 33: /* term: SYMBOL '(' term_seq ')'  */
+#line 259 "parser.ypp"
+     {
+       (yyval.term_attr) = makeNode<FunctionTerm>((yyvsp[-3].name_attr), *(yyvsp[-1].term_seq_attr));
        delete (yyvsp[-1].term_seq_attr);
      }
-#line 1547 "parser.cpp" /* yacc.c:1646  */
+#line 1466 "parser.cpp"
     break;
 
 
-#line 1551 "parser.cpp" /* yacc.c:1646  */
+#line 1470 "parser.cpp"
+
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -1561,25 +1481,23 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
   /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
@@ -1590,50 +1508,14 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
-      {
-        char const *yymsgp = YY_("syntax error");
-        int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
-        if (yysyntax_error_status == 0)
-          yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
-          {
-            if (yymsg != yymsgbuf)
-              YYSTACK_FREE (yymsg);
-            yymsg = (char *) YYSTACK_ALLOC (yymsg_alloc);
-            if (!yymsg)
-              {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
-              }
-            else
-              {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
-              }
-          }
-        yyerror (yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
-      }
-# undef YYSYNTAX_ERROR
-#endif
+      yyerror (ctx, YY_("syntax error"));
     }
 
-
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
@@ -1648,7 +1530,7 @@ yyerrlab:
       else
         {
           yydestruct ("Error: discarding",
-                      yytoken, &yylval);
+                      yytoken, &yylval, ctx);
           yychar = YYEMPTY;
         }
     }
@@ -1662,12 +1544,11 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
-
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
@@ -1684,13 +1565,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -1704,7 +1586,7 @@ yyerrlab1:
 
 
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, ctx);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -1716,7 +1598,7 @@ yyerrlab1:
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -1727,33 +1609,37 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
-  yyerror (YY_("memory exhausted"));
+  yyerror (ctx, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
+
 
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
          user semantic actions for why this is necessary.  */
       yytoken = YYTRANSLATE (yychar);
       yydestruct ("Cleanup: discarding lookahead",
-                  yytoken, &yylval);
+                  yytoken, &yylval, ctx);
     }
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
@@ -1762,18 +1648,16 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[*yyssp], yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, ctx);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
+
   return yyresult;
 }
-#line 230 "parser.ypp" /* yacc.c:1906  */
+
+#line 265 "parser.ypp"
 
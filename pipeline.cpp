@@ -0,0 +1,146 @@
+#include "pipeline.hpp"
+#include "nodefactory.hpp"
+#include "parsecontext.hpp"
+#include "sink.hpp"
+
+Pipeline::Worker::Worker()
+    :input(arenasPerWorker),
+      free(arenasPerWorker),
+      output(arenasPerWorker)
+{
+    for(size_t i = 0; i < arenasPerWorker; i++) {
+        arenas.push_back(unique_ptr<Arena>(new Arena()));
+        free.push(arenas.back().get());
+    }
+}
+
+Pipeline::Pipeline(unsigned jobs, bool optIndicator, outputFormat format)
+    :_optIndicator(optIndicator),
+      _format(format),
+      _seq(0),
+      _finished(false)
+{
+    for(unsigned i = 0; i < jobs; i++)
+        _workers.push_back(unique_ptr<Worker>(new Worker()));
+
+    for(auto & w : _workers)
+        w->translator = thread(&Pipeline::translate, this, ref(*w));
+}
+
+Pipeline::~Pipeline()
+{
+    finish();
+
+    for(auto & w : _workers)
+        w->translator.join();
+}
+
+void Pipeline::finish()
+{
+    if(_finished)
+        return;
+    _finished = true;
+
+    for(size_t i = 0; i < _workers.size(); i++)
+        _workers[(_seq + i) % _workers.size()]->input.push(Chunk());
+}
+
+void Pipeline::translate(Worker & worker)
+{
+    // Cvorovi prevoda idu u arenu niti, a stabla naredbi su u areni paketa.
+    Arena arena;
+    Arena::setCurrent(&arena);
+    MemorySink buffer;
+    ostream out(&buffer);
+
+    while(true) {
+        Chunk chunk = worker.input.pop();
+
+        Output output;
+        if(chunk.arena == nullptr) {
+            output.end = true;
+            worker.output.push(move(output));
+            return;
+        }
+
+        for(const Statement & s : chunk.statements) {
+            if(s.formula != nullptr)
+                s.formula->doTheMagic(_optIndicator, _format, out);
+            else
+                printStatementError(s.error, _format, out);
+
+            NodeFactory::clear();
+            arena.release();
+        }
+
+        chunk.statements.clear();
+        chunk.arena->release();
+        worker.free.push(chunk.arena);
+
+        output.text = buffer.take();
+        worker.output.push(move(output));
+    }
+}
+
+void Pipeline::write(ostream & ostr)
+{
+    for(size_t seq = 0; ; seq++) {
+        Output output = _workers[seq % _workers.size()]->output.pop();
+        if(output.end)
+            return;
+        ostr << output.text;
+    }
+}
+
+void Pipeline::scan(ParseContext & ctx, ostream & ostr)
+{
+    thread writer(&Pipeline::write, this, ref(ostr));
+    Arena * statementArena = Arena::current();
+
+    bool done = false;
+    while(!done) {
+        Worker & worker = *_workers[_seq % _workers.size()];
+
+        Chunk chunk;
+        chunk.arena = worker.free.pop();
+        Arena::setCurrent(chunk.arena);
+
+        while(chunk.statements.size() < chunkSize) {
+            ctx.parse();
+
+            if(ctx.exitIndicator) {
+                done = true;
+                break;
+            }
+
+            Statement s;
+            if(ctx.printIndicator)
+                s.formula = ctx.parsedFormula;
+            else {
+                s.formula = nullptr;
+                s.error = ctx.errorMessage;
+            }
+            chunk.statements.push_back(move(s));
+        }
+
+        worker.input.push(move(chunk));
+        _seq++;
+    }
+
+    Arena::setCurrent(statementArena);
+    finish();
+    writer.join();
+}
+
+void Pipeline::run(FILE * in, ostream & ostr)
+{
+    ParseContext ctx(in);
+    scan(ctx, ostr);
+}
+
+void Pipeline::run(char * text, size_t length, ostream & ostr)
+{
+    ParseContext ctx;
+    ctx.scanInPlace(text, length);
+    scan(ctx, ostr);
+}
@@ -0,0 +1,101 @@
+#ifndef _PIPELINE_H
+#define _PIPELINE_H
+
+#include <cstdio>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "fol.hpp"
+#include "queue.hpp"
+
+using namespace std;
+
+class ParseContext;
+
+/* Protocni rezim (--pipeline N). Nit koja pozove run() samo skenira i
+   parsira, N niti prevodi, a posebna nit ispisuje, pa se citanje ulaza,
+   prevodjenje i ispis preklapaju.
+
+   Naredbe putuju u paketima (Chunk) od najvise chunkSize naredbi.
+   Stabla naredbi jednog paketa su u jednoj areni, koju nit prevodioca
+   po zavrsetku oslobadja i vraca skeneru. Paket k ide niti k % N, pa
+   su svi redovi izmedju niti SpscQueue, a ispis cita niti istim redom
+   i ne mora da preuredjuje prevode. Ispis je isti kao u obicnom
+   rezimu. */
+class Pipeline {
+public:
+    Pipeline(unsigned jobs, bool optIndicator, outputFormat format);
+    ~Pipeline();
+
+    Pipeline(const Pipeline &) = delete;
+    Pipeline & operator = (const Pipeline &) = delete;
+
+    /* Prevodi naredbe iz in do naredbe exit ili kraja ulaza; poziva
+       se samo jednom. */
+    void run(FILE * in, ostream & ostr);
+
+    /* Isto, za niz koji se skenira u mestu (vidi ParseContext::scanInPlace). */
+    void run(char * text, size_t length, ostream & ostr);
+
+    static const size_t chunkSize = 256;
+
+    /* Broj areni (paketa u obradi) po niti prevodioca. */
+    static const size_t arenasPerWorker = 2;
+
+private:
+    struct Statement {
+        /* nullptr ako naredba nije ispravna; tada je poruka u error. */
+        Formula formula;
+        string error;
+    };
+
+    /* Paket bez arene oznacava kraj ulaza. */
+    struct Chunk {
+        Chunk()
+            :arena(nullptr)
+        {}
+
+        Arena * arena;
+        vector<Statement> statements;
+    };
+
+    struct Output {
+        Output()
+            :end(false)
+        {}
+
+        string text;
+        bool end;
+    };
+
+    struct Worker {
+        Worker();
+
+        SpscQueue<Chunk> input;
+        SpscQueue<Arena *> free;
+        SpscQueue<Output> output;
+        vector<unique_ptr<Arena> > arenas;
+        thread translator;
+    };
+
+    void translate(Worker & worker);
+    void write(ostream & ostr);
+    void scan(ParseContext & ctx, ostream & ostr);
+
+    /* Salje svim nitima prevodioca oznaku kraja, redom kojim bi
+       dobijale sledece pakete. */
+    void finish();
+
+    bool _optIndicator;
+    outputFormat _format;
+    vector<unique_ptr<Worker> > _workers;
+
+    // Redni broj sledeceg paketa i da li je kraj vec poslat.
+    size_t _seq;
+    bool _finished;
+};
+
+#endif // _PIPELINE_H
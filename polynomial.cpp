@@ -0,0 +1,626 @@
+#include "polynomial.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+thread_local MonomialOrder Polynomial::order = GREVLEX;
+
+void printVar(std::ostream & ostr, Var v)
+{
+    ostr << SymbolTable::name(varPoint(v)) << apendAxis(varAxis(v));
+}
+
+// Bajt stepena u prvoj reci, najvisi bitovi bajtova i ostali bitovi.
+static const uint64_t degreeMask = 0xff00000000000000ULL;
+static const uint64_t highBits = 0x8080808080808080ULL;
+static const uint64_t lowBits = 0x7f7f7f7f7f7f7f7fULL;
+
+static void degreeOverflow()
+{
+    throw std::overflow_error("Monomial: degree exceeds 127");
+}
+
+Monomial Monomial::variable(Var v, unsigned exp)
+{
+    if(exp > maxDegree)
+        degreeOverflow();
+    if(exp == 0)
+        return Monomial();
+    if(v > lastInlineVar)
+        return fromFactors(Factors(1, std::make_pair(v, exp)), exp);
+
+    unsigned slot = v + 1;
+    Monomial m(slot / 8 + 1);
+    std::fill(m._inline, m._inline + m._size, 0);
+    m._inline[0] |= (uint64_t)exp << 56;
+    m._inline[slot / 8] |= (uint64_t)exp << shift(slot);
+    return m;
+}
+
+void Monomial::trim()
+{
+    while(_size > 0 && _inline[_size - 1] == 0)
+        _size--;
+}
+
+Monomial Monomial::fromFactors(Factors factors, unsigned degree)
+{
+    if(degree > maxDegree)
+        degreeOverflow();
+    if(factors.empty())
+        return Monomial();
+
+    if(factors.back().first > lastInlineVar) {
+        Monomial m;
+        m._sparse = new Sparse{std::move(factors), degree};
+        m._size = sparseSize;
+        return m;
+    }
+
+    Monomial m(inlineWords);
+    std::fill(m._inline, m._inline + inlineWords, 0);
+    m._inline[0] = (uint64_t)degree << 56;
+    for(const auto & f : factors) {
+        unsigned slot = f.first + 1;
+        m._inline[slot / 8] |= (uint64_t)f.second << shift(slot);
+    }
+    m.trim();
+    return m;
+}
+
+const Monomial::Factors & Monomial::factorsOf(const Monomial & m, Factors & buffer)
+{
+    if(m.isSparse())
+        return m._sparse->factors;
+    buffer = m.factors();
+    return buffer;
+}
+
+unsigned Monomial::sparseExponent(Var v) const
+{
+    const Factors & f = _sparse->factors;
+    auto it = std::lower_bound(f.begin(), f.end(), std::make_pair(v, 0u));
+    return it != f.end() && it->first == v ? it->second : 0;
+}
+
+Var Monomial::lastVariable() const
+{
+    if(isSparse())
+        return _sparse->factors.back().first;
+    if(_size == 0)
+        return NO_VAR;
+
+    uint64_t w = _inline[_size - 1];
+    if(_size == 1)
+        w &= ~degreeMask;
+    unsigned slot = 8 * (_size - 1) + 7 - __builtin_ctzll(w) / 8;
+    return slot - 1;
+}
+
+Monomial::Factors Monomial::factors() const
+{
+    if(isSparse())
+        return _sparse->factors;
+
+    Factors result;
+    for(unsigned i = 0; i < _size; i++) {
+        uint64_t w = _inline[i];
+        if(i == 0)
+            w &= ~degreeMask;
+
+        while(w != 0) {
+            unsigned slot = 8 * i + __builtin_clzll(w) / 8;
+            result.push_back(std::make_pair(slot - 1, (unsigned)(w >> shift(slot)) & 0xff));
+            w &= ~((uint64_t)0xff << shift(slot));
+        }
+    }
+    return result;
+}
+
+Monomial Monomial::operator * (const Monomial & m) const
+{
+    if(isSparse() || m.isSparse())
+        return sparseProduct(*this, m);
+    if(degree() + m.degree() > maxDegree)
+        degreeOverflow();
+
+    // Bajtovi se ne prenose jedan u drugi, jer je zbir stepena ispod 128.
+    const Monomial & longer = _size >= m._size ? *this : m;
+    const Monomial & shorter = _size >= m._size ? m : *this;
+
+    Monomial r(longer._size);
+    uint64_t * w = r._inline;
+    for(unsigned i = 0; i < shorter._size; i++)
+        w[i] = longer._inline[i] + shorter._inline[i];
+    std::copy(longer._inline + shorter._size, longer._inline + longer._size, w + shorter._size);
+    return r;
+}
+
+Monomial Monomial::operator / (const Monomial & m) const
+{
+    if(isSparse() || m.isSparse())
+        return sparseQuotient(*this, m);
+
+    Monomial r(_size);
+    uint64_t * w = r._inline;
+    for(unsigned i = 0; i < _size; i++)
+        w[i] = _inline[i] - word(m, i);
+    r.trim();
+    return r;
+}
+
+/* Za bajtove ispod 128, (b | 0x80) - a ne pozajmljuje iz susednog
+   bajta, a najvisi bit ostaje postavljen tacno kada je b >= a. */
+bool Monomial::divides(const Monomial & m) const
+{
+    if(isSparse() || m.isSparse())
+        return sparseDivides(*this, m);
+    if(_size > m._size)
+        return false;
+
+    for(unsigned i = 0; i < _size; i++)
+        if((((m._inline[i] | highBits) - _inline[i]) & highBits) != highBits)
+            return false;
+    return true;
+}
+
+bool Monomial::isCoprime(const Monomial & m) const
+{
+    if(isSparse() || m.isSparse())
+        return sparseCoprime(*this, m);
+
+    // x + 0x7f ima najvisi bit bajta postavljen tacno kada bajt nije nula.
+    unsigned size = std::min(_size, m._size);
+    for(unsigned i = 0; i < size; i++) {
+        uint64_t a = _inline[i], b = m._inline[i];
+        if(i == 0) {
+            a &= ~degreeMask;
+            b &= ~degreeMask;
+        }
+        if(((a + lowBits) & (b + lowBits) & highBits) != 0)
+            return false;
+    }
+    return true;
+}
+
+Monomial Monomial::lcm(const Monomial & m1, const Monomial & m2)
+{
+    if(m1.isSparse() || m2.isSparse())
+        return sparseLcm(m1, m2);
+
+    unsigned size = std::max(m1._size, m2._size);
+    Monomial r(size);
+    uint64_t * w = r._inline;
+
+    unsigned degree = 0;
+    for(unsigned i = 0; i < size; i++) {
+        uint64_t a = word(m1, i), b = word(m2, i);
+        if(i == 0) {
+            a &= ~degreeMask;
+            b &= ~degreeMask;
+        }
+
+        // Maska bajtova u kojima je a >= b, pa maksimum po bajtovima.
+        uint64_t ge = ((a | highBits) - b) & highBits;
+        uint64_t mask = (ge >> 7) * 0xff;
+        w[i] = (a & mask) | (b & ~mask);
+
+        // Zbir bajtova reci je najvisi bajt proizvoda sa 0x0101...01.
+        degree += (w[i] * 0x0101010101010101ULL) >> 56;
+    }
+
+    if(degree > maxDegree)
+        degreeOverflow();
+    if(size > 0)
+        w[0] |= (uint64_t)degree << 56;
+    return r;
+}
+
+/* LEX i GRLEX porede reci kao brojeve (GRLEX zajedno sa stepenom).
+   Kod GREVLEX-a, kod jednakog stepena, manji je monom sa vecim
+   izloziocem u poslednjoj promenljivoj u kojoj se razlikuju: reci se
+   porede od poslednje, a obrtanjem bajtova poslednja promenljiva reci
+   postaje njen najvisi bajt. */
+int Monomial::compare(const Monomial & m1, const Monomial & m2, MonomialOrder order)
+{
+    if(m1.isSparse() || m2.isSparse())
+        return sparseCompare(m1, m2, order);
+
+    unsigned size = std::max(m1._size, m2._size);
+
+    if(order == GREVLEX) {
+        unsigned d1 = m1.degree(), d2 = m2.degree();
+        if(d1 != d2)
+            return d1 > d2 ? 1 : -1;
+
+        for(unsigned i = size; i-- > 0; ) {
+            uint64_t a = word(m1, i), b = word(m2, i);
+            if(a == b)
+                continue;
+            a = __builtin_bswap64(i == 0 ? a & ~degreeMask : a);
+            b = __builtin_bswap64(i == 0 ? b & ~degreeMask : b);
+            return (a < b) - (a > b);
+        }
+        return 0;
+    }
+
+    for(unsigned i = 0; i < size; i++) {
+        uint64_t a = word(m1, i), b = word(m2, i);
+        if(i == 0 && order == LEX) {
+            a &= ~degreeMask;
+            b &= ~degreeMask;
+        }
+        if(a != b)
+            return (a > b) - (a < b);
+    }
+    return 0;
+}
+
+/* Retki oblik: iste operacije spajanjem sortiranih lista faktora. */
+Monomial Monomial::sparseProduct(const Monomial & m1, const Monomial & m2)
+{
+    Factors b1, b2;
+    const Factors & f1 = factorsOf(m1, b1);
+    const Factors & f2 = factorsOf(m2, b2);
+
+    Factors r;
+    r.reserve(f1.size() + f2.size());
+    auto i = f1.begin();
+    auto j = f2.begin();
+    while(i != f1.end() && j != f2.end()) {
+        if(i->first < j->first)
+            r.push_back(*i++);
+        else if(j->first < i->first)
+            r.push_back(*j++);
+        else {
+            r.push_back(std::make_pair(i->first, i->second + j->second));
+            ++i;
+            ++j;
+        }
+    }
+    r.insert(r.end(), i, f1.end());
+    r.insert(r.end(), j, f2.end());
+    return fromFactors(std::move(r), m1.degree() + m2.degree());
+}
+
+Monomial Monomial::sparseQuotient(const Monomial & m1, const Monomial & m2)
+{
+    Factors b1, b2;
+    const Factors & f1 = factorsOf(m1, b1);
+    const Factors & f2 = factorsOf(m2, b2);
+
+    Factors r;
+    r.reserve(f1.size());
+    auto j = f2.begin();
+    for(const auto & f : f1) {
+        unsigned exp = f.second;
+        if(j != f2.end() && j->first == f.first)
+            exp -= (j++)->second;
+        if(exp > 0)
+            r.push_back(std::make_pair(f.first, exp));
+    }
+    return fromFactors(std::move(r), m1.degree() - m2.degree());
+}
+
+bool Monomial::sparseDivides(const Monomial & m1, const Monomial & m2)
+{
+    if(m1.degree() > m2.degree())
+        return false;
+
+    Factors b1, b2;
+    const Factors & f1 = factorsOf(m1, b1);
+    const Factors & f2 = factorsOf(m2, b2);
+
+    auto j = f2.begin();
+    for(const auto & f : f1) {
+        while(j != f2.end() && j->first < f.first)
+            ++j;
+        if(j == f2.end() || j->first != f.first || j->second < f.second)
+            return false;
+        ++j;
+    }
+    return true;
+}
+
+bool Monomial::sparseCoprime(const Monomial & m1, const Monomial & m2)
+{
+    Factors b1, b2;
+    const Factors & f1 = factorsOf(m1, b1);
+    const Factors & f2 = factorsOf(m2, b2);
+
+    auto i = f1.begin();
+    auto j = f2.begin();
+    while(i != f1.end() && j != f2.end()) {
+        if(i->first == j->first)
+            return false;
+        if(i->first < j->first)
+            ++i;
+        else
+            ++j;
+    }
+    return true;
+}
+
+Monomial Monomial::sparseLcm(const Monomial & m1, const Monomial & m2)
+{
+    Factors b1, b2;
+    const Factors & f1 = factorsOf(m1, b1);
+    const Factors & f2 = factorsOf(m2, b2);
+
+    Factors r;
+    r.reserve(f1.size() + f2.size());
+    auto i = f1.begin();
+    auto j = f2.begin();
+    while(i != f1.end() && j != f2.end()) {
+        if(i->first < j->first)
+            r.push_back(*i++);
+        else if(j->first < i->first)
+            r.push_back(*j++);
+        else {
+            r.push_back(std::make_pair(i->first, std::max(i->second, j->second)));
+            ++i;
+            ++j;
+        }
+    }
+    r.insert(r.end(), i, f1.end());
+    r.insert(r.end(), j, f2.end());
+
+    unsigned degree = 0;
+    for(const auto & f : r)
+        degree += f.second;
+    return fromFactors(std::move(r), degree);
+}
+
+int Monomial::sparseCompare(const Monomial & m1, const Monomial & m2, MonomialOrder order)
+{
+    if(order != LEX && m1.degree() != m2.degree())
+        return m1.degree() > m2.degree() ? 1 : -1;
+
+    Factors b1, b2;
+    const Factors & f1 = factorsOf(m1, b1);
+    const Factors & f2 = factorsOf(m2, b2);
+
+    if(order == GREVLEX) {
+        // Kod jednakog stepena je manji monom koji ima veci izlozilac
+        // u poslednjoj promenljivoj u kojoj se razlikuju.
+        auto i = f1.rbegin();
+        auto j = f2.rbegin();
+        for(; i != f1.rend() && j != f2.rend(); ++i, ++j) {
+            if(i->first != j->first)
+                return i->first > j->first ? -1 : 1;
+            if(i->second != j->second)
+                return i->second > j->second ? -1 : 1;
+        }
+        return 0;
+    }
+
+    // LEX, i GRLEX kod jednakog stepena.
+    auto i = f1.begin();
+    auto j = f2.begin();
+    for(; i != f1.end() && j != f2.end(); ++i, ++j) {
+        if(i->first != j->first)
+            return i->first < j->first ? 1 : -1;
+        if(i->second != j->second)
+            return i->second > j->second ? 1 : -1;
+    }
+
+    if(i != f1.end())
+        return 1;
+    if(j != f2.end())
+        return -1;
+    return 0;
+}
+
+void Monomial::print(std::ostream & ostr) const
+{
+    Factors f = factors();
+    for(unsigned i = 0; i < f.size(); i++) {
+        if(i > 0)
+            ostr << "*";
+        printVar(ostr, f[i].first);
+        if(f[i].second > 1)
+            ostr << "^" << f[i].second;
+    }
+}
+
+Polynomial::Polynomial(const Rational & c)
+{
+    if(!c.isZero())
+        _terms.push_back(Term(Monomial(), c));
+}
+
+Polynomial::Polynomial(const Monomial & m, const Rational & c)
+{
+    if(!c.isZero())
+        _terms.push_back(Term(m, c));
+}
+
+Polynomial Polynomial::variable(Var v)
+{
+    return Polynomial(Monomial::variable(v));
+}
+
+Polynomial Polynomial::operator + (const Polynomial & p) const
+{
+    Polynomial r;
+    r._terms.reserve(_terms.size() + p._terms.size());
+
+    auto i = _terms.begin();
+    auto j = p._terms.begin();
+    while(i != _terms.end() && j != p._terms.end()) {
+        int c = Monomial::compare(i->first, j->first, order);
+        if(c > 0)
+            r._terms.push_back(*i++);
+        else if(c < 0)
+            r._terms.push_back(*j++);
+        else {
+            Rational sum = i->second + j->second;
+            if(!sum.isZero())
+                r._terms.push_back(Term(i->first, sum));
+            ++i;
+            ++j;
+        }
+    }
+    r._terms.insert(r._terms.end(), i, _terms.end());
+    r._terms.insert(r._terms.end(), j, p._terms.end());
+
+    return r;
+}
+
+Polynomial Polynomial::operator - () const
+{
+    Polynomial r = *this;
+    for(auto & t : r._terms)
+        t.second = -t.second;
+    return r;
+}
+
+Polynomial Polynomial::operator - (const Polynomial & p) const
+{
+    return *this + (-p);
+}
+
+Polynomial Polynomial::operator * (const Polynomial & p) const
+{
+    Polynomial r;
+    r._terms.reserve(_terms.size() * p._terms.size());
+
+    for(const auto & t1 : _terms)
+        for(const auto & t2 : p._terms)
+            r._terms.push_back(Term(t1.first * t2.first, t1.second * t2.second));
+
+    r.sortAndCombine();
+    return r;
+}
+
+Polynomial Polynomial::times(const Monomial & m, const Rational & c) const
+{
+    Polynomial r;
+    if(c.isZero())
+        return r;
+
+    r._terms.reserve(_terms.size());
+    for(const auto & t : _terms)
+        r._terms.push_back(Term(t.first * m, t.second * c));
+    return r;
+}
+
+Polynomial Polynomial::monic() const
+{
+    if(_terms.empty() || leadingCoefficient().isOne())
+        return *this;
+
+    Rational inverse = Rational(1) / leadingCoefficient();
+    Polynomial r = *this;
+    for(auto & t : r._terms)
+        t.second *= inverse;
+    return r;
+}
+
+Polynomial Polynomial::sorted() const
+{
+    Polynomial r = *this;
+    r.sortAndCombine();
+    return r;
+}
+
+void Polynomial::sortAndCombine()
+{
+    std::sort(_terms.begin(), _terms.end(), [](const Term & t1, const Term & t2) {
+        return Monomial::compare(t1.first, t2.first, order) > 0;
+    });
+
+    Terms combined;
+    combined.reserve(_terms.size());
+    for(const auto & t : _terms) {
+        if(!combined.empty() && combined.back().first == t.first)
+            combined.back().second += t.second;
+        else
+            combined.push_back(t);
+
+        if(combined.back().second.isZero())
+            combined.pop_back();
+    }
+
+    _terms.swap(combined);
+}
+
+Polynomial Polynomial::normalized() const
+{
+    if(_terms.empty())
+        return *this;
+
+    Rational content;
+    for(const auto & t : _terms)
+        content = Rational::gcd(content, t.second);
+
+    Rational factor = Rational(1) / content;
+    if(leadingCoefficient().isNegative())
+        factor = -factor;
+
+    Polynomial r = *this;
+    for(auto & t : r._terms)
+        t.second *= factor;
+    return r;
+}
+
+Polynomial Polynomial::renamed(const std::vector<Var> & vars) const
+{
+    Polynomial r;
+    r._terms.reserve(_terms.size());
+
+    for(const auto & t : _terms) {
+        Monomial m;
+        bool zero = false;
+        for(const auto & f : t.first.factors()) {
+            if(vars[f.first] == NO_VAR) {
+                zero = true;
+                break;
+            }
+            m = m * Monomial::variable(vars[f.first], f.second);
+        }
+
+        if(!zero)
+            r._terms.push_back(Term(m, t.second));
+    }
+
+    r.sortAndCombine();
+    return r;
+}
+
+void Polynomial::print(std::ostream & ostr) const
+{
+    if(_terms.empty()) {
+        ostr << "0";
+        return;
+    }
+
+    for(unsigned i = 0; i < _terms.size(); i++) {
+        const Monomial & m = _terms[i].first;
+        Rational c = _terms[i].second;
+
+        if(i == 0) {
+            if(c.isNegative())
+                ostr << "-";
+        }
+        else
+            ostr << (c.isNegative() ? " - " : " + ");
+
+        if(c.isNegative())
+            c = -c;
+
+        if(m.isOne())
+            ostr << c;
+        else {
+            if(!c.isOne())
+                ostr << c << "*";
+            m.print(ostr);
+        }
+    }
+}
+
+std::ostream & operator << (std::ostream & ostr, const Polynomial & p)
+{
+    p.print(ostr);
+    return ostr;
+}
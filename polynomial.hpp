@@ -0,0 +1,370 @@
+#ifndef _POLYNOMIAL_H
+#define _POLYNOMIAL_H
+
+#include <algorithm>
+#include <cstdint>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "rational.hpp"
+#include "symbols.hpp"
+
+/* Promenljiva polinoma je jedna koordinata: 2 * tacka + osa.
+   Promenljive sa manjim indeksom su vece u svim uredjenjima. */
+typedef unsigned Var;
+
+static const Var NO_VAR = (Var)-1;
+
+static inline Var coordinateVar(PointId point, axis a)
+{
+    return 2 * point + a;
+}
+
+static inline PointId varPoint(Var v)
+{
+    return v / 2;
+}
+
+static inline axis varAxis(Var v)
+{
+    return (axis)(v % 2);
+}
+
+void printVar(std::ostream & ostr, Var v);
+
+enum MonomialOrder {
+    LEX,
+    GRLEX,
+    GREVLEX
+};
+
+/* Monom kao gust niz izlozilaca po 8 bita, spakovan u 64-bitne reci.
+   Najvisi bajt prve reci je ukupan stepen, a iza njega su izlozioci
+   promenljivih 0, 1, 2, ... od visih bajtova reci ka nizim, pa se LEX i
+   GRLEX svode na poredjenje reci kao brojeva, a GREVLEX na poredjenje
+   reci od poslednje, sa obrnutim redosledom bajtova.
+
+   Stepen je najvise 127, pa nijedan izlozilac ne dira najvisi bit
+   svog bajta: mnozenje je sabiranje reci, a deljivost, NZS i uzajamna
+   prostost se racunaju nad svih osam bajtova reci odjednom. Monomi sa
+   promenljivima do 30 staju u objekat. Monom sa vecim indeksom cuva se
+   retko, kao lista (promenljiva, izlozilac) na hipu, pa mu velicina ne
+   raste sa brojem tacaka u ulazu; takvi monomi nastaju pri prevodu, a
+   dokazivac prenumerise promenljive (vidi prover.cpp) i radi sa gustim. */
+class Monomial {
+public:
+    /* Najveci dozvoljeni ukupan stepen. */
+    static const unsigned maxDegree = 127;
+
+    Monomial()
+        :_size(0)
+    {}
+
+    typedef std::vector<std::pair<Var, unsigned> > Factors;
+
+    Monomial(const Monomial & m)
+        :_size(m._size)
+    {
+        if(isSparse())
+            _sparse = new Sparse(*m._sparse);
+        else
+            std::copy(m._inline, m._inline + _size, _inline);
+    }
+
+    Monomial(Monomial && m) noexcept
+        :_size(m._size)
+    {
+        if(isSparse()) {
+            _sparse = m._sparse;
+            m._size = 0;
+        }
+        else
+            std::copy(m._inline, m._inline + _size, _inline);
+    }
+
+    ~Monomial()
+    {
+        if(isSparse())
+            delete _sparse;
+    }
+
+    Monomial & operator = (const Monomial & m)
+    {
+        if(!isSparse() && !m.isSparse()) {
+            _size = m._size;
+            std::copy(m._inline, m._inline + _size, _inline);
+        }
+        else if(this != &m)
+            *this = Monomial(m);
+        return *this;
+    }
+
+    Monomial & operator = (Monomial && m) noexcept
+    {
+        if(this == &m)
+            return *this;
+        if(isSparse())
+            delete _sparse;
+
+        _size = m._size;
+        if(isSparse()) {
+            _sparse = m._sparse;
+            m._size = 0;
+        }
+        else
+            std::copy(m._inline, m._inline + _size, _inline);
+        return *this;
+    }
+
+    /* Baca overflow_error ako je exp > maxDegree. */
+    static Monomial variable(Var v, unsigned exp = 1);
+
+    unsigned degree() const
+    {
+        if(isSparse())
+            return _sparse->degree;
+        return _size == 0 ? 0 : (unsigned)(_inline[0] >> 56);
+    }
+
+    bool isOne() const
+    {
+        return _size == 0;
+    }
+
+    unsigned exponent(Var v) const
+    {
+        if(isSparse())
+            return sparseExponent(v);
+        unsigned slot = v + 1;
+        if(slot / 8 >= _size)
+            return 0;
+        return (unsigned)(_inline[slot / 8] >> shift(slot)) & 0xff;
+    }
+
+    /* Promenljiva najveceg indeksa, ili NO_VAR za monom 1. */
+    Var lastVariable() const;
+
+    /* (promenljiva, izlozilac) za promenljive sa pozitivnim izloziocem,
+       sortirano po promenljivoj. */
+    Factors factors() const;
+
+    /* Baca overflow_error ako stepen proizvoda predje maxDegree. */
+    Monomial operator * (const Monomial & m) const;
+
+    /* Kolicnik; m mora deliti ovaj monom. */
+    Monomial operator / (const Monomial & m) const;
+
+    /* Da li ovaj monom deli m. */
+    bool divides(const Monomial & m) const;
+
+    /* Da li monomi nemaju zajednicku promenljivu. */
+    bool isCoprime(const Monomial & m) const;
+
+    static Monomial lcm(const Monomial & m1, const Monomial & m2);
+
+    /* Oblik je odredjen poslednjom promenljivom, pa su gust i redak
+       monom uvek razliciti. */
+    bool operator == (const Monomial & m) const
+    {
+        if(isSparse() && m.isSparse())
+            return _sparse->degree == m._sparse->degree &&
+                    _sparse->factors == m._sparse->factors;
+        return _size == m._size &&
+                std::equal(_inline, _inline + _size, m._inline);
+    }
+
+    bool operator != (const Monomial & m) const
+    {
+        return !(*this == m);
+    }
+
+    /* -1, 0 ili 1 u zadatom uredjenju. */
+    static int compare(const Monomial & m1, const Monomial & m2, MonomialOrder order);
+
+    void print(std::ostream & ostr) const;
+
+private:
+    static const unsigned inlineWords = 4;
+
+    /* Najveca promenljiva gustog oblika. */
+    static const Var lastInlineVar = 8 * inlineWords - 2;
+
+    // Vrednost _size monoma u retkom obliku.
+    static const unsigned sparseSize = inlineWords + 1;
+
+    struct Sparse {
+        Factors factors;
+        unsigned degree;
+    };
+
+    bool isSparse() const
+    {
+        return _size == sparseSize;
+    }
+
+    /* Pomeraj bajta sa rednim brojem slot (0 je stepen) unutar reci. */
+    static unsigned shift(unsigned slot)
+    {
+        return 8 * (7 - slot % 8);
+    }
+
+    /* Gust monom od size reci sa nedefinisanim sadrzajem. */
+    explicit Monomial(unsigned size)
+        :_size(size)
+    {}
+
+    static uint64_t word(const Monomial & m, unsigned i)
+    {
+        return i < m._size ? m._inline[i] : 0;
+    }
+
+    /* Uklanja nula reci sa kraja. */
+    void trim();
+
+    unsigned sparseExponent(Var v) const;
+
+    /* Monom sa datim (sortiranim) faktorima i stepenom, u gustom obliku
+       ako mu sve promenljive staju u objekat. */
+    static Monomial fromFactors(Factors factors, unsigned degree);
+
+    /* Faktori monoma bez kopiranja za redak oblik; buffer cuva faktore
+       gustog. */
+    static const Factors & factorsOf(const Monomial & m, Factors & buffer);
+
+    // Operacije kada je bar jedan monom redak.
+    static Monomial sparseProduct(const Monomial & m1, const Monomial & m2);
+    static Monomial sparseQuotient(const Monomial & m1, const Monomial & m2);
+    static bool sparseDivides(const Monomial & m1, const Monomial & m2);
+    static bool sparseCoprime(const Monomial & m1, const Monomial & m2);
+    static Monomial sparseLcm(const Monomial & m1, const Monomial & m2);
+    static int sparseCompare(const Monomial & m1, const Monomial & m2, MonomialOrder order);
+
+    // Broj reci gustog oblika (poslednja rec nije nula), ili sparseSize.
+    unsigned _size;
+    union {
+        uint64_t _inline[inlineWords];
+        Sparse * _sparse;
+    };
+};
+
+/* Polinom sa racionalnim koeficijentima kao lista (monom, koeficijent)
+   sortirana opadajuce u uredjenju Polynomial::order, bez nula. */
+class Polynomial {
+public:
+    typedef std::pair<Monomial, Rational> Term;
+    typedef std::vector<Term> Terms;
+
+    Polynomial()
+    {}
+
+    Polynomial(const Rational & c);
+
+    Polynomial(const Monomial & m, const Rational & c = 1);
+
+    /* Termovi moraju vec biti sortirani u uredjenju order, bez nula. */
+    explicit Polynomial(Terms terms)
+        :_terms(std::move(terms))
+    {}
+
+    static Polynomial variable(Var v);
+
+    const Terms & terms() const
+    {
+        return _terms;
+    }
+
+    size_t size() const
+    {
+        return _terms.size();
+    }
+
+    bool isZero() const
+    {
+        return _terms.empty();
+    }
+
+    bool isConstant() const
+    {
+        return _terms.empty() || (_terms.size() == 1 && _terms[0].first.isOne());
+    }
+
+    const Monomial & leadingMonomial() const
+    {
+        return _terms[0].first;
+    }
+
+    const Rational & leadingCoefficient() const
+    {
+        return _terms[0].second;
+    }
+
+    Polynomial operator + (const Polynomial & p) const;
+    Polynomial operator - (const Polynomial & p) const;
+    Polynomial operator * (const Polynomial & p) const;
+    Polynomial operator - () const;
+
+    /* Proizvod sa termom c * m; redosled termova se ne menja. */
+    Polynomial times(const Monomial & m, const Rational & c) const;
+
+    /* Polinom podeljen vodecim koeficijentom. */
+    Polynomial monic() const;
+
+    /* Isti polinom sortiran u tekucem uredjenju order. */
+    Polynomial sorted() const;
+
+    bool operator == (const Polynomial & p) const
+    {
+        return _terms == p._terms;
+    }
+
+    bool operator != (const Polynomial & p) const
+    {
+        return !(*this == p);
+    }
+
+    /* Kanonski oblik jednacine p = 0: celobrojni koeficijenti bez
+       zajednickog delioca i pozitivan vodeci koeficijent. */
+    Polynomial normalized() const;
+
+    /* Zamenjuje svaku promenljivu v sa vars[v]; ako je vars[v] == NO_VAR
+       promenljiva se zamenjuje nulom. */
+    Polynomial renamed(const std::vector<Var> & vars) const;
+
+    void print(std::ostream & ostr) const;
+
+    /* Uredjenje monoma u kome se cuvaju polinomi; posebno za svaku
+       nit, da bi dokazivaci mogli da rade u drugom uredjenju (vidi
+       OrderScope). */
+    static thread_local MonomialOrder order;
+
+private:
+    Terms _terms;
+
+    void sortAndCombine();
+};
+
+std::ostream & operator << (std::ostream & ostr, const Polynomial & p);
+
+/* Menja Polynomial::order tekuce niti do kraja opsega. */
+class OrderScope {
+public:
+    OrderScope(MonomialOrder order)
+        :_previous(Polynomial::order)
+    {
+        Polynomial::order = order;
+    }
+
+    ~OrderScope()
+    {
+        Polynomial::order = _previous;
+    }
+
+    OrderScope(const OrderScope &) = delete;
+    OrderScope & operator = (const OrderScope &) = delete;
+
+private:
+    MonomialOrder _previous;
+};
+
+#endif // _POLYNOMIAL_H
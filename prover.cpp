@@ -0,0 +1,187 @@
+#include "prover.hpp"
+#include "fol.hpp"
+#include "groebner.hpp"
+#include "sampling.hpp"
+#include "wu.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+/* Fiksna pocetna vrednost, da bi isti ulaz uvek davao isti izlaz. */
+static const uint64_t samplingSeed = 0x5eed2024;
+
+ProverOptions ProverOptions::commandLine;
+
+static ProofResult decideGroebner(const PolynomialSystem & system, const GroebnerBasis & basis)
+{
+    if(basis.isUnit())
+        return ProofResult(PROVED, "hypotheses are contradictory");
+    if(!system.conclusionConsistent)
+        return ProofResult(NOT_PROVED);
+
+    bool radical = false;
+    for(const Polynomial & c : system.conclusion) {
+        if(basis.contains(c))
+            continue;
+        if(!basis.radicalContains(c))
+            return ProofResult(NOT_PROVED);
+        radical = true;
+    }
+
+    return ProofResult(PROVED, radical ? "conclusion is in the radical" : "");
+}
+
+/* Sa --modular se uz rezultat ispisuje koliko je matrica baze dobijeno
+   rekonstrukcijom (ostale su eliminisane tacno); matrice provere
+   radikala se ne broje. */
+static ProofResult proveGroebner(const PolynomialSystem & system, MonomialOrder order,
+                                 groebnerAlgorithm algorithm)
+{
+    GroebnerBasis basis(order, algorithm);
+    for(const Polynomial & h : system.hypotheses)
+        basis.add(h);
+    basis.compute();
+
+    ProofResult result = decideGroebner(system, basis);
+    const GroebnerBasis::Statistics & s = basis.statistics();
+    if(algorithm == f4ModularAlgorithm && s.matrices > 0) {
+        string lifted = to_string(s.liftedMatrices) + " of " + to_string(s.matrices) +
+                " matrices lifted";
+        result.detail = result.detail.empty() ? lifted : result.detail + ", " + lifted;
+    }
+    return result;
+}
+
+static ProofResult proveWu(const PolynomialSystem & system)
+{
+    CharacteristicSet set(system.variables);
+    if(!set.triangulate(system.hypotheses))
+        return ProofResult(PROVED, "hypotheses are contradictory");
+    if(!system.conclusionConsistent)
+        return ProofResult(NOT_PROVED);
+
+    for(const Polynomial & c : system.conclusion)
+        if(!set.remainder(c).isZero())
+            return ProofResult(NOT_PROVED);
+
+    ProofResult result(PROVED);
+    result.conditions = set.initials();
+    return result;
+}
+
+static ProofResult proveRandom(const PolynomialSystem & system, unsigned instances)
+{
+    CharacteristicSet set(system.variables);
+    if(!set.triangulate(system.hypotheses))
+        return ProofResult(PROVED, "hypotheses are contradictory");
+    if(!system.conclusionConsistent)
+        return ProofResult(NOT_PROVED);
+
+    SamplingResult sample = sampleInstances(set, system.hypotheses, system.conclusion,
+                                            instances, samplingSeed);
+    if(sample.counterexample)
+        return ProofResult(NOT_PROVED, "counterexample found");
+    if(sample.valid == 0)
+        return ProofResult(PROOF_UNKNOWN, "no instance satisfies the hypotheses");
+
+    string detail = to_string(sample.valid) + " instances";
+    if(sample.errorBits >= 1)
+        detail += ", error ~ 2^-" + to_string((unsigned)floor(sample.errorBits));
+
+    ProofResult result(PROBABLY_PROVED, detail);
+    result.conditions = set.initials();
+    return result;
+}
+
+/* Prenumerise promenljive sistema u 0, 1, 2, ... cuvajuci njihov
+   poredak, pa se uredjenja monoma ne menjaju, a monomi staju u objekat
+   (vidi Monomial). original[i] je promenljiva koja je dobila broj i. */
+static PolynomialSystem compacted(const PolynomialSystem & system, vector<Var> & original)
+{
+    original = system.variables;
+    for(const vector<Polynomial> * polys : {&system.hypotheses, &system.conclusion})
+        for(const Polynomial & p : *polys)
+            for(const auto & t : p.terms())
+                for(const auto & f : t.first.factors())
+                    original.push_back(f.first);
+    sort(original.begin(), original.end());
+    original.erase(unique(original.begin(), original.end()), original.end());
+
+    vector<Var> index(original.empty() ? 0 : original.back() + 1, NO_VAR);
+    for(unsigned i = 0; i < original.size(); i++)
+        index[original[i]] = i;
+
+    PolynomialSystem local = system;
+    for(Polynomial & p : local.hypotheses)
+        p = p.renamed(index);
+    for(Polynomial & p : local.conclusion)
+        p = p.renamed(index);
+    for(Var & v : local.variables)
+        v = index[v];
+    return local;
+}
+
+ProofResult prove(const PolynomialSystem & system, const ProverOptions & options)
+{
+    if(!system.hasConclusion)
+        throw AlgebrizeError("statement has no conclusion");
+
+    if(!system.hypothesesConsistent)
+        return ProofResult(PROVED, "hypotheses are contradictory");
+
+    vector<Var> original;
+    PolynomialSystem local = compacted(system, original);
+
+    ProofResult result;
+    try {
+        switch(options.engine) {
+        case groebnerEngine:
+            result = proveGroebner(local, options.order, buchbergerAlgorithm);
+            break;
+        case f4Engine:
+            result = proveGroebner(local, options.order,
+                                   options.modular ? f4ModularAlgorithm : f4Algorithm);
+            break;
+        case wuEngine:
+            result = proveWu(local);
+            break;
+        case randomEngine:
+            result = proveRandom(local, options.instances);
+            break;
+        }
+    }
+    catch(const overflow_error &) {
+        return ProofResult(PROOF_UNKNOWN, "degree overflow");
+    }
+    catch(const domain_error &) {
+        return ProofResult(PROOF_UNKNOWN, "coefficient not invertible modulo p");
+    }
+
+    for(Polynomial & c : result.conditions)
+        c = c.renamed(original);
+    return result;
+}
+
+void writeProof(BaseFormula * f, TranslationContext & ctx, ostream & ostr)
+{
+    ProofResult result;
+    try {
+        result = prove(algebrize(f, ctx), ProverOptions::commandLine);
+    }
+    catch(const AlgebrizeError & e) {
+        ostr << e.what() << '\n';
+        return;
+    }
+
+    ostr << (result.status == PROVED ? "proved" :
+             result.status == NOT_PROVED ? "not proved" :
+             result.status == PROBABLY_PROVED ? "probably proved" : "unknown");
+    if(!result.detail.empty())
+        ostr << " (" << result.detail << ")";
+    if(!result.conditions.empty()) {
+        ostr << " if ";
+        for(unsigned i = 0; i < result.conditions.size(); i++)
+            ostr << (i > 0 ? ", " : "") << result.conditions[i] << " != 0";
+    }
+    ostr << '\n';
+}
@@ -0,0 +1,82 @@
+#ifndef _PROVER_H
+#define _PROVER_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "algebrize.hpp"
+
+using namespace std;
+
+/* Algebarski dokazivac za naredbe oblika H => C. Sa Grebnerovim
+   bazama teorema je dokazana ako svaki polinom zakljucka pripada
+   radikalu ideala hipoteza, tj. ako zakljucak vazi u svakoj
+   (kompleksnoj) tacki u kojoj vaze hipoteze; teorema koja vazi samo
+   uz uslove nedegenerisanosti ostaje nedokazana. Wuov metod dokazuje
+   i takve teoreme i vraca uslove pod kojima dokaz vazi. Provera na
+   slucajnim instancama (sampling.hpp) je brza od oba, ali daje samo
+   verovatan dokaz. */
+
+enum proverEngine {
+    groebnerEngine,     // Buhbergerov algoritam (groebner.hpp)
+    f4Engine,           // Grebnerova baza algoritmom F4 (f4.cpp)
+    wuEngine,           // Wuov metod karakteristicnih skupova (wu.hpp)
+    randomEngine        // slucajne instance trougaonog skupa (sampling.hpp)
+};
+
+enum proofStatus {
+    PROVED,
+    NOT_PROVED,
+    PROBABLY_PROVED,    // zakljucak vazi u svim slucajnim instancama
+    PROOF_UNKNOWN       // metod ne moze da odluci, npr. stepen monoma je prevelik
+};
+
+struct ProofResult {
+    ProofResult(proofStatus status = PROOF_UNKNOWN, const string & detail = "")
+        :status(status),
+          detail(detail)
+    {}
+
+    proofStatus status;
+
+    /* Dodatno objasnjenje, npr. "hypotheses are contradictory". */
+    string detail;
+
+    /* Uslovi nedegenerisanosti p != 0 pod kojima dokaz vazi (Wuov
+       metod i slucajne instance); Grebnerove baze ih ne daju. */
+    vector<Polynomial> conditions;
+};
+
+class ProverOptions {
+public:
+    ProverOptions(proverEngine engine = groebnerEngine, MonomialOrder order = GREVLEX,
+                  bool modular = false, unsigned instances = 32)
+        :engine(engine),
+          order(order),
+          modular(modular),
+          instances(instances)
+    {}
+
+    proverEngine engine;
+    MonomialOrder order;
+
+    /* F4 eliminise po prostim brojevima (f4ModularAlgorithm). */
+    bool modular;
+
+    /* Broj slucajnih instanci za randomEngine. */
+    unsigned instances;
+
+    /* Podesavanja opcije --prove; main ih postavlja pre prevoda. */
+    static ProverOptions commandLine;
+};
+
+/* Baca AlgebrizeError ako naredba nema zakljucak. */
+ProofResult prove(const PolynomialSystem & system,
+                  const ProverOptions & options = ProverOptions());
+
+/* Dokazuje parsiranu naredbu sa ProverOptions::commandLine i ispisuje
+   jedan red rezultata, npr. "proved" (opcija --prove). */
+void writeProof(BaseFormula * f, TranslationContext & ctx, ostream & ostr);
+
+#endif // _PROVER_H
@@ -0,0 +1,95 @@
+#ifndef _QUEUE_H
+#define _QUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/* Cekanje na praznom ili punom redu: prvo se nit samo odrice procesora,
+   a ako cekanje potraje spava sve duze (najvise 1ms). */
+class Backoff {
+public:
+    Backoff()
+        :_count(0)
+    {}
+
+    void wait()
+    {
+        if(_count < 64)
+            this_thread::yield();
+        else
+            this_thread::sleep_for(chrono::microseconds(1 << (_count < 74 ? _count - 64 : 10)));
+        _count++;
+    }
+
+private:
+    unsigned _count;
+};
+
+/* Ograniceni red bez zakljucavanja za tacno jednog proizvodjaca i
+   jednog potrosaca (kruzni bafer). Proizvodjac menja samo _tail, a
+   potrosac samo _head, pa su dovoljne acquire/release operacije. */
+template<typename T>
+class SpscQueue {
+public:
+    SpscQueue(size_t capacity)
+        :_slots(capacity + 1),
+          _head(0),
+          _tail(0)
+    {}
+
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue & operator = (const SpscQueue &) = delete;
+
+    /* Vraca false (i ne dira value) ako je red pun. */
+    bool tryPush(T & value)
+    {
+        size_t tail = _tail.load(memory_order_relaxed);
+        size_t next = tail + 1 == _slots.size() ? 0 : tail + 1;
+        if(next == _head.load(memory_order_acquire))
+            return false;
+
+        _slots[tail] = move(value);
+        _tail.store(next, memory_order_release);
+        return true;
+    }
+
+    /* Vraca false ako je red prazan. */
+    bool tryPop(T & value)
+    {
+        size_t head = _head.load(memory_order_relaxed);
+        if(head == _tail.load(memory_order_acquire))
+            return false;
+
+        value = move(_slots[head]);
+        _head.store(head + 1 == _slots.size() ? 0 : head + 1, memory_order_release);
+        return true;
+    }
+
+    void push(T value)
+    {
+        Backoff backoff;
+        while(!tryPush(value))
+            backoff.wait();
+    }
+
+    T pop()
+    {
+        T value;
+        Backoff backoff;
+        while(!tryPop(value))
+            backoff.wait();
+        return value;
+    }
+
+private:
+    vector<T> _slots;
+    alignas(64) atomic<size_t> _head;
+    alignas(64) atomic<size_t> _tail;
+};
+
+#endif // _QUEUE_H
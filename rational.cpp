@@ -0,0 +1,120 @@
+#include "rational.hpp"
+
+BigInt Rational::bigNum() const
+{
+    return isSmall() ? BigInt(_num) : _big->num;
+}
+
+BigInt Rational::bigDen() const
+{
+    return isSmall() ? BigInt(_den) : _big->den;
+}
+
+void Rational::spill(BigInt num, BigInt den)
+{
+    if(den.isNegative()) {
+        num = -num;
+        den = -den;
+    }
+
+    BigInt g = BigInt::gcd(num, den);
+    if(!g.isOne()) {
+        num = num / g;
+        den = den / g;
+    }
+
+    int64_t n, d;
+    if(num.toInt64(n) && den.toInt64(d)) {
+        _num = n;
+        _den = d;
+        return;
+    }
+
+    _big = new BigRational{move(num), move(den)};
+    _den = 0;
+}
+
+Rational Rational::general(const Rational & r1, const Rational & r2, char op)
+{
+    BigInt n1 = r1.bigNum(), d1 = r1.bigDen();
+    BigInt n2 = r2.bigNum(), d2 = r2.bigDen();
+
+    Rational r;
+    switch(op) {
+    case '+':
+        r.spill(n1 * d2 + n2 * d1, d1 * d2);
+        break;
+    case '-':
+        r.spill(n1 * d2 - n2 * d1, d1 * d2);
+        break;
+    case '*':
+        r.spill(n1 * n2, d1 * d2);
+        break;
+    default:
+        r.spill(n1 * d2, d1 * n2);
+        break;
+    }
+    return r;
+}
+
+Rational Rational::numerator() const
+{
+    if(isSmall())
+        return Rational(_num);
+    Rational r;
+    r.spill(_big->num, BigInt(1));
+    return r;
+}
+
+Rational Rational::denominator() const
+{
+    if(isSmall())
+        return Rational(_den);
+    Rational r;
+    r.spill(_big->den, BigInt(1));
+    return r;
+}
+
+void Rational::residues(uint32_t m, uint32_t & num, uint32_t & den) const
+{
+    if(isSmall()) {
+        uint64_t a = _num < 0 ? -(uint64_t)_num : (uint64_t)_num;
+        num = (uint32_t)(a % m);
+        den = (uint32_t)((uint64_t)_den % m);
+    }
+    else {
+        num = _big->num.magnitudeMod(m);
+        den = _big->den.magnitudeMod(m);
+    }
+
+    if(isNegative() && num != 0)
+        num = m - num;
+}
+
+Rational Rational::gcd(const Rational & r1, const Rational & r2)
+{
+    if(r1.isSmall() && r2.isSmall()) {
+        __int128 d = gcd128(r1._den, r2._den);
+        return make(gcd128(r1._num, r2._num), r1._den / d * r2._den);
+    }
+
+    BigInt d1 = r1.bigDen(), d2 = r2.bigDen();
+    Rational r;
+    r.spill(BigInt::gcd(r1.bigNum(), r2.bigNum()), d1 / BigInt::gcd(d1, d2) * d2);
+    return r;
+}
+
+std::ostream & operator << (std::ostream & ostr, const Rational & r)
+{
+    if(r.isSmall()) {
+        ostr << r._num;
+        if(r._den != 1)
+            ostr << "/" << r._den;
+    }
+    else {
+        ostr << r._big->num;
+        if(!r._big->den.isOne())
+            ostr << "/" << r._big->den;
+    }
+    return ostr;
+}
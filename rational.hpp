@@ -0,0 +1,308 @@
+#ifndef _RATIONAL_H
+#define _RATIONAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+
+#include "bigint.hpp"
+
+/* Racionalni broj, uvek u skracenom obliku sa pozitivnim imeniocem.
+   Brojilac i imenilac koji staju u 64 bita cuvaju se u samom objektu i
+   racunaju se u 128 bita; tek rezultat koji ne staje u 64 bita prelazi
+   u BigInt na hipu. Koeficijenti sablona su skoro uvek mali, pa racun
+   sa njima ne alocira, a racun sa velikim ostaje tacan. Veliki oblik
+   imaju samo vrednosti koje ne staju u mali, pa je zapis jedinstven. */
+class Rational {
+public:
+    Rational(int64_t num = 0)
+        :_num(num),
+          _den(1)
+    {
+        if(num == INT64_MIN)
+            normalize(num, 1);
+    }
+
+    Rational(int64_t num, int64_t den)
+    {
+        if(den == 0)
+            throw std::domain_error("Rational: division by zero");
+        normalize(num, den);
+    }
+
+    Rational(const Rational & r)
+        :_den(r._den)
+    {
+        if(r.isSmall())
+            _num = r._num;
+        else
+            _big = new BigRational(*r._big);
+    }
+
+    Rational(Rational && r) noexcept
+        :_den(r._den)
+    {
+        if(r.isSmall())
+            _num = r._num;
+        else {
+            _big = r._big;
+            r._num = 0;
+            r._den = 1;
+        }
+    }
+
+    ~Rational()
+    {
+        if(!isSmall())
+            delete _big;
+    }
+
+    Rational & operator = (const Rational & r)
+    {
+        if(isSmall() && r.isSmall()) {
+            _num = r._num;
+            _den = r._den;
+        }
+        else if(this != &r) {
+            Rational copy(r);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    Rational & operator = (Rational && r) noexcept
+    {
+        swap(r);
+        return *this;
+    }
+
+    /* Da li su brojilac i imenilac u samom objektu. */
+    bool isSmall() const
+    {
+        return _den != 0;
+    }
+
+    /* Brojilac i imenilac malog broja; za veliki bacaju overflow_error. */
+    int64_t num() const
+    {
+        if(!isSmall())
+            throw std::overflow_error("Rational: coefficient does not fit in 64 bits");
+        return _num;
+    }
+
+    int64_t den() const
+    {
+        if(!isSmall())
+            throw std::overflow_error("Rational: coefficient does not fit in 64 bits");
+        return _den;
+    }
+
+    /* Brojilac i imenilac kao celi brojevi, bilo koje velicine. */
+    Rational numerator() const;
+    Rational denominator() const;
+
+    bool isZero() const
+    {
+        return isSmall() && _num == 0;
+    }
+
+    bool isOne() const
+    {
+        return isSmall() && _num == 1 && _den == 1;
+    }
+
+    bool isMinusOne() const
+    {
+        return isSmall() && _num == -1 && _den == 1;
+    }
+
+    bool isInteger() const
+    {
+        return isSmall() ? _den == 1 : _big->den.isOne();
+    }
+
+    bool isNegative() const
+    {
+        return isSmall() ? _num < 0 : _big->num.isNegative();
+    }
+
+    Rational operator - () const
+    {
+        if(isSmall())
+            return Rational(-_num, _den, Reduced());
+        return general(*this, Rational(-1), '*');
+    }
+
+    Rational operator + (const Rational & r) const
+    {
+        if(isSmall() && r.isSmall())
+            return make((__int128)_num * r._den + (__int128)r._num * _den,
+                        (__int128)_den * r._den);
+        return general(*this, r, '+');
+    }
+
+    Rational operator - (const Rational & r) const
+    {
+        if(isSmall() && r.isSmall())
+            return make((__int128)_num * r._den - (__int128)r._num * _den,
+                        (__int128)_den * r._den);
+        return general(*this, r, '-');
+    }
+
+    Rational operator * (const Rational & r) const
+    {
+        if(isSmall() && r.isSmall())
+            return make((__int128)_num * r._num, (__int128)_den * r._den);
+        return general(*this, r, '*');
+    }
+
+    Rational operator / (const Rational & r) const
+    {
+        if(r.isZero())
+            throw std::domain_error("Rational: division by zero");
+        if(isSmall() && r.isSmall())
+            return make((__int128)_num * r._den, (__int128)_den * r._num);
+        return general(*this, r, '/');
+    }
+
+    Rational & operator += (const Rational & r)
+    {
+        return *this = *this + r;
+    }
+
+    Rational & operator -= (const Rational & r)
+    {
+        return *this = *this - r;
+    }
+
+    Rational & operator *= (const Rational & r)
+    {
+        return *this = *this * r;
+    }
+
+    bool operator == (const Rational & r) const
+    {
+        if(isSmall() && r.isSmall())
+            return _num == r._num && _den == r._den;
+        if(isSmall() || r.isSmall())
+            return false;
+        return _big->num == r._big->num && _big->den == r._big->den;
+    }
+
+    bool operator != (const Rational & r) const
+    {
+        return !(*this == r);
+    }
+
+    bool operator < (const Rational & r) const
+    {
+        if(isSmall() && r.isSmall())
+            return (__int128)_num * r._den < (__int128)r._num * _den;
+        return general(*this, r, '-').isNegative();
+    }
+
+    size_t hash() const
+    {
+        if(isSmall())
+            return (size_t)_num * 0x9e3779b97f4a7c15ULL ^ (size_t)_den;
+        return _big->num.hash() * 0x9e3779b97f4a7c15ULL ^ _big->den.hash();
+    }
+
+    /* Ostaci brojioca i imenioca po modulu m, u [0, m). */
+    void residues(uint32_t m, uint32_t & num, uint32_t & den) const;
+
+    /* Najveci zajednicki delilac nzd(a, c) / nzs(b, d) razlomaka a/b i
+       c/d, nenegativan; deljenjem njime koeficijenti polinoma postaju
+       uzajamno prosti celi brojevi. */
+    static Rational gcd(const Rational & r1, const Rational & r2);
+
+    void swap(Rational & r) noexcept
+    {
+        int64_t num = _num, den = _den;
+        _num = r._num;
+        _den = r._den;
+        r._num = num;
+        r._den = den;
+    }
+
+private:
+    struct BigRational {
+        BigInt num;
+        BigInt den;
+    };
+
+    struct Reduced {};
+
+    Rational(int64_t num, int64_t den, Reduced)
+        :_num(num),
+          _den(den)
+    {}
+
+    // Veliki oblik ima _den == 0, a vrednost je u _big.
+    union {
+        int64_t _num;
+        BigRational * _big;
+    };
+    int64_t _den;
+
+    static __int128 gcd128(__int128 a, __int128 b)
+    {
+        if(a < 0)
+            a = -a;
+        if(b < 0)
+            b = -b;
+        while(b != 0) {
+            __int128 t = a % b;
+            a = b;
+            b = t;
+        }
+        return a;
+    }
+
+    /* Postavlja vrednost num/den; objekat ne sme imati veliki oblik. */
+    void normalize(__int128 num, __int128 den)
+    {
+        if(den < 0) {
+            num = -num;
+            den = -den;
+        }
+
+        __int128 g = gcd128(num, den);
+        if(g > 1) {
+            num /= g;
+            den /= g;
+        }
+
+        if(num > INT64_MAX || num < -INT64_MAX || den > INT64_MAX) {
+            spill(BigInt(num), BigInt(den));
+            return;
+        }
+
+        _num = (int64_t)num;
+        _den = (int64_t)den;
+    }
+
+    static Rational make(__int128 num, __int128 den)
+    {
+        Rational r;
+        r.normalize(num, den);
+        return r;
+    }
+
+    BigInt bigNum() const;
+    BigInt bigDen() const;
+
+    /* Postavlja num/den, skracen: u malom obliku ako staje, inace u
+       velikom. Kao i normalize, ne oslobadja prethodnu vrednost. */
+    void spill(BigInt num, BigInt den);
+
+    /* Operacija op (+, -, *, /) kada bar jedan broj ima veliki oblik. */
+    static Rational general(const Rational & r1, const Rational & r2, char op);
+
+    friend std::ostream & operator << (std::ostream & ostr, const Rational & r);
+};
+
+std::ostream & operator << (std::ostream & ostr, const Rational & r);
+
+#endif // _RATIONAL_H
@@ -0,0 +1,250 @@
+#include "sampling.hpp"
+
+#include <cmath>
+#include <map>
+#include <random>
+#include <stdexcept>
+
+/* Prost broj polja; p = 3 mod 4. */
+static const uint32_t samplingPrime = 2147483647u;
+
+namespace {
+
+class InstanceBatch {
+public:
+    InstanceBatch(const PrimeField & field, unsigned size, uint64_t seed)
+        :_field(field),
+          _valid(size, true),
+          _random(seed)
+    {}
+
+    /* Vrednosti promenljive u svim instancama; slobodna promenljiva
+       pri prvom pozivu dobija slucajne vrednosti. */
+    const vector<uint32_t> & value(Var v);
+
+    vector<uint32_t> evaluate(const Polynomial & p);
+
+    /* Racuna glavnu promenljivu x iz f; instance u kojima to nije
+       moguce se odbacuju. */
+    void solve(const Polynomial & f, Var x);
+
+    /* Odbacuje instance u kojima vrednost nije nula. */
+    void require(const vector<uint32_t> & values);
+
+    bool anyNonzero(const vector<uint32_t> & values) const;
+
+    unsigned validCount() const;
+
+private:
+    vector<uint32_t> invert(const vector<uint32_t> & a);
+    uint32_t power(uint32_t a, uint64_t e) const;
+
+    const PrimeField & _field;
+    vector<bool> _valid;
+    map<Var, vector<uint32_t> > _values;
+    mt19937_64 _random;
+};
+
+}
+
+const vector<uint32_t> & InstanceBatch::value(Var v)
+{
+    auto it = _values.find(v);
+    if(it != _values.end())
+        return it->second;
+
+    vector<uint32_t> values(_valid.size());
+    for(uint32_t & x : values)
+        x = (uint32_t)(_random() % _field.prime());
+    return _values[v] = values;
+}
+
+uint32_t InstanceBatch::power(uint32_t a, uint64_t e) const
+{
+    uint32_t r = 1;
+    while(e > 0) {
+        if(e & 1)
+            r = _field.mul(r, a);
+        a = _field.mul(a, a);
+        e >>= 1;
+    }
+    return r;
+}
+
+vector<uint32_t> InstanceBatch::evaluate(const Polynomial & p)
+{
+    unsigned n = _valid.size();
+    vector<uint32_t> result(n, 0);
+    vector<uint32_t> term(n);
+
+    for(const auto & t : p.terms()) {
+        uint32_t c;
+        if(!_field.fromRational(t.second, c))
+            throw domain_error("coefficient denominator is divisible by the sampling prime");
+
+        fill(term.begin(), term.end(), c);
+        for(const auto & f : t.first.factors()) {
+            const vector<uint32_t> & v = value(f.first);
+            for(unsigned i = 0; i < n; i++)
+                term[i] = _field.mul(term[i], power(v[i], f.second));
+        }
+
+        for(unsigned i = 0; i < n; i++)
+            result[i] = _field.add(result[i], term[i]);
+    }
+
+    return result;
+}
+
+/* Montgomerijev trik: proizvodi prefiksa, jedan inverz, pa se
+   inverzi pojedinacnih clanova dobijaju unazad. */
+vector<uint32_t> InstanceBatch::invert(const vector<uint32_t> & a)
+{
+    unsigned n = a.size();
+    vector<uint32_t> prefix(n), result(n, 0);
+
+    uint32_t product = 1;
+    for(unsigned i = 0; i < n; i++) {
+        if(_valid[i] && a[i] == 0)
+            _valid[i] = false;
+        prefix[i] = product;
+        if(_valid[i])
+            product = _field.mul(product, a[i]);
+    }
+
+    uint32_t inverse = _field.inverse(product);
+    for(unsigned i = n; i-- > 0; ) {
+        if(!_valid[i])
+            continue;
+        result[i] = _field.mul(inverse, prefix[i]);
+        inverse = _field.mul(inverse, a[i]);
+    }
+
+    return result;
+}
+
+void InstanceBatch::solve(const Polynomial & f, Var x)
+{
+    unsigned n = _valid.size();
+    unsigned d = CharacteristicSet::degree(f, x);
+    vector<uint32_t> values(n, 0);
+
+    if(d == 1) {
+        vector<uint32_t> a0 = evaluate(CharacteristicSet::coefficient(f, x, 0));
+        vector<uint32_t> inverse = invert(evaluate(CharacteristicSet::coefficient(f, x, 1)));
+        for(unsigned i = 0; i < n; i++)
+            if(_valid[i])
+                values[i] = _field.neg(_field.mul(a0[i], inverse[i]));
+    }
+    else if(d == 2) {
+        vector<uint32_t> a0 = evaluate(CharacteristicSet::coefficient(f, x, 0));
+        vector<uint32_t> a1 = evaluate(CharacteristicSet::coefficient(f, x, 1));
+        vector<uint32_t> a2 = evaluate(CharacteristicSet::coefficient(f, x, 2));
+
+        vector<uint32_t> twice(n);
+        for(unsigned i = 0; i < n; i++)
+            twice[i] = _field.add(a2[i], a2[i]);
+        vector<uint32_t> inverse = invert(twice);
+
+        for(unsigned i = 0; i < n; i++) {
+            if(!_valid[i])
+                continue;
+
+            uint32_t disc = _field.sub(_field.mul(a1[i], a1[i]),
+                                       _field.mul(4, _field.mul(a2[i], a0[i])));
+            uint32_t root = power(disc, ((uint64_t)_field.prime() + 1) / 4);
+            if(_field.mul(root, root) != disc) {
+                _valid[i] = false;
+                continue;
+            }
+
+            if(_random() & 1)
+                root = _field.neg(root);
+            values[i] = _field.mul(_field.sub(root, a1[i]), inverse[i]);
+        }
+    }
+    else
+        fill(_valid.begin(), _valid.end(), false);
+
+    _values[x] = values;
+}
+
+void InstanceBatch::require(const vector<uint32_t> & values)
+{
+    for(unsigned i = 0; i < values.size(); i++)
+        if(values[i] != 0)
+            _valid[i] = false;
+}
+
+bool InstanceBatch::anyNonzero(const vector<uint32_t> & values) const
+{
+    for(unsigned i = 0; i < values.size(); i++)
+        if(_valid[i] && values[i] != 0)
+            return true;
+    return false;
+}
+
+unsigned InstanceBatch::validCount() const
+{
+    unsigned count = 0;
+    for(bool v : _valid)
+        count += v;
+    return count;
+}
+
+/* Gornja granica stepena polinoma p posle zamene glavnih promenljivih
+   racionalnim funkcijama slobodnih i oslobadjanja od imenilaca. */
+static double degreeBound(const Polynomial & p, Var skip, const map<Var, double> & degrees)
+{
+    map<Var, unsigned> exponents;
+    for(const auto & t : p.terms())
+        for(const auto & f : t.first.factors())
+            if(f.first != skip && f.second > exponents[f.first])
+                exponents[f.first] = f.second;
+
+    double bound = 0;
+    for(const auto & e : exponents) {
+        auto it = degrees.find(e.first);
+        bound += e.second * (it == degrees.end() ? 1.0 : it->second);
+    }
+    return bound;
+}
+
+SamplingResult sampleInstances(const CharacteristicSet & set,
+                               const vector<Polynomial> & hypotheses,
+                               const vector<Polynomial> & conclusion,
+                               unsigned instances, uint64_t seed)
+{
+    PrimeField field(samplingPrime);
+    InstanceBatch batch(field, instances, seed);
+    map<Var, double> degrees;
+
+    const vector<Polynomial> & chain = set.chain();
+    for(auto it = chain.rbegin(); it != chain.rend(); ++it) {
+        Var x = set.mainVariable(*it);
+        batch.solve(*it, x);
+        degrees[x] = max(1.0, degreeBound(*it, x, degrees)) *
+                (CharacteristicSet::degree(*it, x) > 1 ? 2 : 1);
+    }
+
+    for(const Polynomial & h : hypotheses)
+        batch.require(batch.evaluate(h));
+
+    SamplingResult result;
+    result.valid = batch.validCount();
+    if(result.valid == 0)
+        return result;
+
+    double bound = 1;
+    for(const Polynomial & c : conclusion) {
+        if(batch.anyNonzero(batch.evaluate(c))) {
+            result.counterexample = true;
+            return result;
+        }
+        bound = max(bound, degreeBound(c, NO_VAR, degrees));
+    }
+
+    if(bound < samplingPrime)
+        result.errorBits = result.valid * log2(samplingPrime / bound);
+    return result;
+}
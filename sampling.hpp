@@ -0,0 +1,57 @@
+#ifndef _SAMPLING_H
+#define _SAMPLING_H
+
+#include <cstdint>
+#include <vector>
+
+#include "modular.hpp"
+#include "wu.hpp"
+
+using namespace std;
+
+/* Provera teoreme na slucajnim instancama nad poljem ostataka po
+   p = 2^31 - 1. Slobodne promenljive trougaonog skupa (one koje nisu
+   glavne ni u jednom polinomu) dobijaju slucajne vrednosti, a glavne
+   promenljive se racunaju redom, od najnize: linearni korak deljenjem
+   inicijalom, kvadratni korak korenom diskriminante (p = 3 mod 4, pa
+   je koren stepen (p + 1) / 4). Instanca koja ne zadovoljava sve
+   hipoteze, ili kod koje je neki inicijal nula, odbacuje se.
+
+   Sve instance se racunaju zajedno, kao nizovi vrednosti po
+   promenljivoj; inverzi svih inicijala jednog koraka se dobijaju
+   jednim invertovanjem (Montgomerijev trik).
+
+   Ako zakljucak ne vazi, njegov ostatak je nenula polinom R stepena
+   najvise D po slobodnim promenljivim, pa je po Schwartz-Zippelovoj
+   lemi verovatnoca da R nestane u jednoj instanci najvise D / p. D se
+   procenjuje odozgo iz stepena polinoma skupa; za kvadratne korake
+   ta procena je samo okvirna, pa se greska ispisuje kao procena
+   (error ~ 2^-N), a ne kao dokazana granica. */
+
+struct SamplingResult {
+    SamplingResult()
+        :valid(0),
+          counterexample(false),
+          errorBits(0)
+    {}
+
+    /* Broj instanci koje zadovoljavaju hipoteze. */
+    unsigned valid;
+
+    /* Da li u nekoj instanci zakljucak ne vazi. */
+    bool counterexample;
+
+    /* Procena verovatnoce greske, 2^-errorBits, ako nema
+       kontraprimera. */
+    double errorBits;
+};
+
+/* hypotheses su polinomi iz kojih je napravljen set; instances je broj
+   pokusaja, a seed pocetna vrednost generatora. Baca domain_error ako
+   p deli imenilac nekog koeficijenta. */
+SamplingResult sampleInstances(const CharacteristicSet & set,
+                               const vector<Polynomial> & hypotheses,
+                               const vector<Polynomial> & conclusion,
+                               unsigned instances, uint64_t seed);
+
+#endif // _SAMPLING_H
@@ -0,0 +1,239 @@
+#include "server.hpp"
+#include "fol.hpp"
+#include "nodefactory.hpp"
+#include "parsecontext.hpp"
+#include "sink.hpp"
+
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static runtime_error socketError(const string & path)
+{
+    return runtime_error("cannot listen on " + path + ": " + strerror(errno));
+}
+
+static bool blank(const string & s)
+{
+    for(char c : s)
+        if(!isspace((unsigned char)c))
+            return false;
+    return true;
+}
+
+/* Salje ceo niz; vraca false ako je klijent zatvorio vezu. */
+static bool sendAll(int fd, const char * data, size_t length)
+{
+    while(length > 0) {
+        ssize_t n = send(fd, data, length, MSG_NOSIGNAL);
+        if(n < 0) {
+            if(errno == EINTR)
+                continue;
+            return false;
+        }
+        data += n;
+        length -= n;
+    }
+    return true;
+}
+
+Server::Server(const char * path, unsigned jobs, bool optIndicator, outputFormat format)
+    :_optIndicator(optIndicator),
+      _format(format),
+      _path(path),
+      _listenFd(-1),
+      _done(false)
+{
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if(_path.size() >= sizeof(addr.sun_path))
+        throw runtime_error("socket path is too long: " + _path);
+    strcpy(addr.sun_path, path);
+
+    // Soket koji je ostao od prethodnog pokretanja se brise, a
+    // postojeca datoteka nekog drugog tipa ne.
+    struct stat st;
+    if(stat(path, &st) == 0 && S_ISSOCK(st.st_mode))
+        unlink(path);
+
+    _listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(_listenFd < 0)
+        throw socketError(_path);
+
+    if(bind(_listenFd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+            listen(_listenFd, SOMAXCONN) < 0) {
+        runtime_error e = socketError(_path);
+        close(_listenFd);
+        throw e;
+    }
+
+    for(unsigned i = 0; i < jobs; i++)
+        _threads.push_back(thread(&Server::worker, this));
+}
+
+Server::~Server()
+{
+    {
+        lock_guard<mutex> lock(_mutex);
+        _done = true;
+    }
+    _requestReady.notify_all();
+
+    for(auto & t : _threads)
+        t.join();
+
+    close(_listenFd);
+    unlink(_path.c_str());
+}
+
+void Server::run()
+{
+    while(true) {
+        int fd = accept(_listenFd, nullptr, nullptr);
+        if(fd < 0) {
+            if(errno == EINTR || errno == ECONNABORTED)
+                continue;
+            throw socketError(_path);
+        }
+
+        // Veza zivi koliko i klijent; server radi do kraja procesa.
+        thread(&Server::serve, this, fd).detach();
+    }
+}
+
+void Server::serve(int fd)
+{
+    string pending;
+    char buffer[4096];
+    bool eof = false;
+
+    while(!eof) {
+        ssize_t n = read(fd, buffer, sizeof(buffer));
+        if(n < 0 && errno == EINTR)
+            continue;
+
+        // Na kraju veze ostatak bez ';' je poslednji zahtev.
+        eof = n <= 0;
+        if(eof)
+            pending += '\n';
+        else
+            pending.append(buffer, n);
+
+        deque<Request> requests;
+        size_t start = 0;
+        for(size_t i = 0; i < pending.size(); i++) {
+            if(pending[i] != ';' && pending[i] != '\n')
+                continue;
+
+            string text = pending.substr(start, i - start);
+            start = i + 1;
+            if(blank(text))
+                continue;
+
+            Request r;
+            r.text = text + ";";
+            r.received = chrono::steady_clock::now();
+            r.exit = false;
+            r.done = false;
+            requests.push_back(move(r));
+        }
+        pending.erase(0, start);
+
+        if(requests.empty())
+            continue;
+
+        {
+            unique_lock<mutex> lock(_mutex);
+            for(Request & r : requests)
+                _queue.push_back(&r);
+            _requestReady.notify_all();
+
+            _replyReady.wait(lock, [&requests] {
+                for(const Request & r : requests)
+                    if(!r.done)
+                        return false;
+                return true;
+            });
+        }
+
+        for(const Request & r : requests) {
+            if(r.exit) {
+                eof = true;
+                break;
+            }
+            if(!sendAll(fd, r.reply.data(), r.reply.size())) {
+                eof = true;
+                break;
+            }
+        }
+    }
+
+    close(fd);
+}
+
+void Server::worker()
+{
+    // Kao u paketnom rezimu, svaka nit ima svoju arenu i svoj parser.
+    Arena arena;
+    Arena::setCurrent(&arena);
+    ParseContext ctx;
+    MemorySink buffer;
+    ostream out(&buffer);
+    vector<Request *> batch;
+
+    while(true) {
+        {
+            unique_lock<mutex> lock(_mutex);
+            _requestReady.wait(lock, [this] { return _done || !_queue.empty(); });
+            if(_done)
+                return;
+
+            // Zahtevi se dele na niti, ali nit ne uzima vise od batchSize.
+            size_t n = (_queue.size() + _threads.size() - 1) / _threads.size();
+            if(n > batchSize)
+                n = batchSize;
+            while(n-- > 0) {
+                batch.push_back(_queue.front());
+                _queue.pop_front();
+            }
+        }
+
+        for(Request * r : batch) {
+            translate(ctx, out, *r);
+            auto latency = chrono::duration_cast<chrono::microseconds>(
+                        chrono::steady_clock::now() - r->received);
+            r->reply = to_string(latency.count()) + " " + buffer.take();
+        }
+
+        {
+            lock_guard<mutex> lock(_mutex);
+            for(Request * r : batch)
+                r->done = true;
+        }
+        _replyReady.notify_all();
+        batch.clear();
+    }
+}
+
+void Server::translate(ParseContext & ctx, ostream & out, Request & request)
+{
+    ctx.setInput(request.text.data(), request.text.size());
+    ctx.parse();
+
+    if(ctx.exitIndicator)
+        request.exit = true;
+    else if(ctx.printIndicator)
+        ctx.parsedFormula->doTheMagic(_optIndicator, _format, out);
+    else
+        printStatementError(ctx.errorMessage, _format, out);
+
+    NodeFactory::clear();
+    Arena::current()->release();
+}
@@ -0,0 +1,72 @@
+#ifndef _SERVER_H
+#define _SERVER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "fol.hpp"
+
+using namespace std;
+
+class ParseContext;
+
+/* Serverski rezim (--listen PATH). Program ostaje pokrenut i prima
+   naredbe preko lokalnog Unix soketa, pa se parsiranje sablona, kes
+   prevoda i tabela simbola ne prave iznova za svaki upit.
+
+   Zahtev je jedna naredba; zavrsava se sa ';' ili krajem reda. Za
+   svaki zahtev klijent dobija jedan red oblika
+       <latencija u mikrosekundama> <prevod>
+   redosledom kojim je slao zahteve. Naredba exit zatvara vezu.
+
+   Svaka veza ima svoju nit koja samo cita i pise; prevode rade
+   zajednicke niti koje iz reda uzimaju vise zahteva odjednom, pa se
+   istovremeni zahtevi razlicitih klijenata obradjuju u paketima. */
+class Server {
+public:
+    Server(const char * path, unsigned jobs, bool optIndicator, outputFormat format);
+    ~Server();
+
+    Server(const Server &) = delete;
+    Server & operator = (const Server &) = delete;
+
+    /* Prihvata veze; vraca se samo zbog greske (izuzetak). */
+    void run();
+
+    /* Najveci broj zahteva koje nit uzima iz reda odjednom. */
+    static const size_t batchSize = 64;
+
+private:
+    struct Request {
+        string text;
+        chrono::steady_clock::time_point received;
+        string reply;
+        bool exit;
+        bool done;
+    };
+
+    void serve(int fd);
+    void worker();
+    void translate(ParseContext & ctx, ostream & out, Request & request);
+
+    bool _optIndicator;
+    outputFormat _format;
+    string _path;
+    int _listenFd;
+
+    vector<thread> _threads;
+
+    mutex _mutex;
+    condition_variable _requestReady;
+    condition_variable _replyReady;
+    deque<Request *> _queue;
+    bool _done;
+};
+
+#endif // _SERVER_H
@@ -0,0 +1,94 @@
+#include "sink.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+OutputSink::OutputSink(size_t capacity)
+    :_buffer(capacity)
+{
+    setp(_buffer.data(), _buffer.data() + _buffer.size());
+}
+
+bool OutputSink::flush()
+{
+    size_t length = pptr() - pbase();
+    setp(_buffer.data(), _buffer.data() + _buffer.size());
+    return length == 0 || write(_buffer.data(), length);
+}
+
+OutputSink::int_type OutputSink::overflow(int_type c)
+{
+    if(!flush())
+        return traits_type::eof();
+
+    if(!traits_type::eq_int_type(c, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+    return traits_type::not_eof(c);
+}
+
+streamsize OutputSink::xsputn(const char * s, streamsize n)
+{
+    if(n <= epptr() - pptr()) {
+        memcpy(pptr(), s, n);
+        pbump(n);
+        return n;
+    }
+
+    if(!flush())
+        return 0;
+
+    // Blok veci od bafera ide direktno u odrediste, bez kopiranja.
+    if((size_t)n >= _buffer.size())
+        return write(s, n) ? n : 0;
+
+    memcpy(pptr(), s, n);
+    pbump(n);
+    return n;
+}
+
+int OutputSink::sync()
+{
+    return flush() ? 0 : -1;
+}
+
+FileSink::~FileSink()
+{
+    flush();
+}
+
+bool FileSink::write(const char * data, size_t length)
+{
+    while(length > 0) {
+        ssize_t n = ::write(_fd, data, length);
+        if(n < 0) {
+            if(errno == EINTR)
+                continue;
+            return false;
+        }
+        data += n;
+        length -= n;
+    }
+    return true;
+}
+
+MemorySink::~MemorySink()
+{
+    flush();
+}
+
+string MemorySink::take()
+{
+    flush();
+    string text;
+    text.swap(_text);
+    return text;
+}
+
+bool MemorySink::write(const char * data, size_t length)
+{
+    _text.append(data, length);
+    return true;
+}
@@ -0,0 +1,71 @@
+#ifndef _SINK_H
+#define _SINK_H
+
+#include <streambuf>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/* Odrediste ispisa prevoda. Printeri pisu u obican ostream nad sinkom,
+   a sink skuplja ispis u baferu i predaje ga odredistu u velikim
+   blokovima; ispis se ne prazni posle svake naredbe, vec kada se bafer
+   napuni ili na eksplicitan flush(). */
+class OutputSink : public streambuf {
+public:
+    OutputSink(size_t capacity = defaultCapacity);
+
+    OutputSink(const OutputSink &) = delete;
+    OutputSink & operator = (const OutputSink &) = delete;
+
+    /* Predaje odredistu sve iz bafera; vraca false ako upis nije uspeo. */
+    bool flush();
+
+    static const size_t defaultCapacity = 64 * 1024;
+
+protected:
+    /* Upisuje blok u odrediste. Izvedene klase u destruktoru pozivaju
+       flush(), jer bazna klasa tada vise ne moze da pozove write. */
+    virtual bool write(const char * data, size_t length) = 0;
+
+    virtual int_type overflow(int_type c);
+    virtual streamsize xsputn(const char * s, streamsize n);
+    virtual int sync();
+
+private:
+    vector<char> _buffer;
+};
+
+/* Ispis u otvoren fajl deskriptor (npr. STDOUT_FILENO). */
+class FileSink : public OutputSink {
+public:
+    FileSink(int fd)
+        :_fd(fd)
+    {}
+
+    ~FileSink();
+
+protected:
+    virtual bool write(const char * data, size_t length);
+
+private:
+    int _fd;
+};
+
+/* Ispis u memoriju. Nit paketnog rezima ima jedan takav bafer i iz
+   njega preuzima prevod svakog bloka. */
+class MemorySink : public OutputSink {
+public:
+    ~MemorySink();
+
+    /* Vraca sve ispisano od poslednjeg take() i prazni bafer. */
+    string take();
+
+protected:
+    virtual bool write(const char * data, size_t length);
+
+private:
+    string _text;
+};
+
+#endif // _SINK_H
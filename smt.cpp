@@ -0,0 +1,446 @@
+#include "smt.hpp"
+
+#include <unordered_map>
+
+/* Ispis jedne naredbe. Prvi prolaz prevodi atome (istim redom kao
+   obican ispis, zbog -o) i broji reference na cvorove prevoda; cvor
+   sa vise referenci dobija ime t<n> i definiciju u let. Let vezivanja
+   su paralelna, pa se definicije rasporedjuju po nivoima: definicija
+   nivoa k koristi samo imena nizih nivoa.
+
+   Uz svaki atom pamte se tacke vezane kvantifikatorima oko njega. Ista
+   tacka moze biti slobodna u jednom atomu, a vezana u drugom, pa se
+   koordinata deklarise ako se bar negde pojavljuje slobodno, a cvor
+   koji bar u jednom atomu sadrzi vezanu koordinatu se ne vezuje u let. */
+class SmtWriter {
+public:
+    SmtWriter(TranslationContext & ctx)
+        :_ctx(ctx),
+          _quantifiers(false)
+    {}
+
+    void write(const Formula & f, ostream & ostr);
+
+private:
+    struct Node {
+        Node()
+            :refs(0),
+              quantified(false),
+              bound(false),
+              depth(-1),
+              name(0)
+        {}
+
+        unsigned refs;
+        bool quantified;
+        bool bound;
+        int depth;
+        unsigned name;
+    };
+
+    void translateAtoms(const Formula & f, vector<PointId> & scope);
+    void count(const Formula & n);
+    bool quantified(const Formula & n, const vector<PointId> & scope,
+                    unordered_map<Formula, bool> & seen);
+    int innerDepth(const Formula & n);
+    void children(const Formula & n, vector<Formula> & ops) const;
+
+    void formula(const Formula & f, ostream & ostr);
+    void connectives(const Formula & f, BaseFormula::Type type, ostream & ostr);
+    void term(const Formula & n, ostream & ostr, bool definition = false);
+    void operands(const Formula & n, ostream & ostr, bool flatten = false);
+
+    void coordinate(PointId point, axis a, ostream & ostr) const
+    {
+        ostr << SymbolTable::name(point) << apendAxis(a);
+    }
+
+    TranslationContext & _ctx;
+    bool _quantifiers;
+
+    // Prevodi atoma i tacke vezane oko svakog od njih.
+    unordered_map<Formula, Formula> _atoms;
+    vector<Formula> _roots;
+    vector<vector<PointId> > _scopes;
+
+    unordered_map<Formula, Node> _nodes;
+    unordered_map<Formula, int> _inner;
+
+    // Cvorovi redom prvog obilaska i slobodne koordinate redom
+    // pojavljivanja.
+    vector<Formula> _order;
+    vector<Var> _coordinates;
+    vector<bool> _declared;
+};
+
+static bool isLeaf(const Formula & n)
+{
+    BaseFormula::Type t = n->getType();
+    return t == BaseFormula::T_LIT || t == BaseFormula::T_CONST ||
+            t == BaseFormula::T_TRUE || t == BaseFormula::T_FALSE;
+}
+
+void SmtWriter::children(const Formula & n, vector<Formula> & ops) const
+{
+    switch(n->getType()){
+    case BaseFormula::T_PLUS:
+    case BaseFormula::T_MINUS:
+    case BaseFormula::T_TIMES:
+    case BaseFormula::T_EQ:
+    case BaseFormula::T_AND:
+    case BaseFormula::T_OR:
+        ops.push_back(((BinaryConjective *)n)->getOperand1());
+        ops.push_back(((BinaryConjective *)n)->getOperand2());
+        break;
+    case BaseFormula::T_POW:
+        // Kvadrat se ispisuje kao (* t t), pa se osnova koristi dva puta.
+        ops.push_back(((Pow *)n)->getOperand());
+        ops.push_back(((Pow *)n)->getOperand());
+        break;
+    case BaseFormula::T_NOT:
+        ops.push_back(((Not *)n)->getOperand());
+        break;
+    default:
+        break;
+    }
+}
+
+void SmtWriter::translateAtoms(const Formula & f, vector<PointId> & scope)
+{
+    switch(f->getType()){
+    case BaseFormula::T_NOT:
+        translateAtoms(((Not *)f)->getOperand(), scope);
+        break;
+    case BaseFormula::T_AND:
+    case BaseFormula::T_OR:
+    case BaseFormula::T_IMP:
+    case BaseFormula::T_IFF:
+        translateAtoms(((BinaryConjective *)f)->getOperand1(), scope);
+        translateAtoms(((BinaryConjective *)f)->getOperand2(), scope);
+        break;
+    case BaseFormula::T_FORALL:
+    case BaseFormula::T_EXISTS:
+        _quantifiers = true;
+        scope.push_back(((Quantifier *)f)->getVariable());
+        translateAtoms(((Quantifier *)f)->getOperand(), scope);
+        scope.pop_back();
+        break;
+    case BaseFormula::T_ATOM:
+    {
+        Formula c = ((Atom *)f)->coordinateFormula(_ctx);
+        _atoms[f] = c;
+        _roots.push_back(c);
+        _scopes.push_back(scope);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void SmtWriter::count(const Formula & n)
+{
+    Node & node = _nodes[n];
+    if(node.refs++ > 0)
+        return;
+
+    _order.push_back(n);
+
+    vector<Formula> ops;
+    children(n, ops);
+    for(const Formula & op : ops)
+        count(op);
+}
+
+/* Da li cvor u atomu sa vezanim tackama scope sadrzi vezanu
+   koordinatu; usput oznacava takve cvorove i belezi slobodne
+   koordinate. seen pamti vec obidjene cvorove istog atoma. */
+bool SmtWriter::quantified(const Formula & n, const vector<PointId> & scope,
+                           unordered_map<Formula, bool> & seen)
+{
+    auto it = seen.find(n);
+    if(it != seen.end())
+        return it->second;
+
+    bool q = false;
+    if(n->getType() == BaseFormula::T_LIT) {
+        PointId p = ((Lit *)n)->getPoint();
+        q = find(scope.begin(), scope.end(), p) != scope.end();
+        Var v = coordinateVar(p, ((Lit *)n)->getAxis());
+        if(v >= _declared.size())
+            _declared.resize(v + 1, false);
+        if(!q && !_declared[v]) {
+            _declared[v] = true;
+            _coordinates.push_back(v);
+        }
+    }
+    else {
+        vector<Formula> ops;
+        children(n, ops);
+        for(const Formula & op : ops)
+            q = quantified(op, scope, seen) || q;
+    }
+
+    if(q)
+        _nodes[n].quantified = true;
+    seen[n] = q;
+    return q;
+}
+
+int SmtWriter::innerDepth(const Formula & n)
+{
+    auto it = _inner.find(n);
+    if(it != _inner.end())
+        return it->second;
+
+    int d = -1;
+    vector<Formula> ops;
+    children(n, ops);
+    for(const Formula & op : ops) {
+        int c = innerDepth(op);
+        if(_nodes[op].bound)
+            c++;
+        if(c > d)
+            d = c;
+    }
+
+    _inner[n] = d;
+    return d;
+}
+
+void SmtWriter::operands(const Formula & n, ostream & ostr, bool flatten)
+{
+    // Lanac iste asocijativne operacije se ispisuje kao jedna.
+    vector<Formula> ops;
+    children(n, ops);
+    for(const Formula & op : ops) {
+        if(flatten && op->getType() == n->getType() && !_nodes[op].bound)
+            operands(op, ostr, true);
+        else {
+            ostr << " ";
+            term(op, ostr);
+        }
+    }
+}
+
+void SmtWriter::term(const Formula & n, ostream & ostr, bool definition)
+{
+    const Node & node = _nodes[n];
+    if(node.bound && !definition) {
+        ostr << "t" << node.name;
+        return;
+    }
+
+    switch(n->getType()){
+    case BaseFormula::T_TRUE:
+        ostr << "true";
+        break;
+    case BaseFormula::T_FALSE:
+        ostr << "false";
+        break;
+    case BaseFormula::T_LIT:
+    {
+        const Lit * l = (Lit *)n;
+        if(l->isNegated()) {
+            ostr << "(- ";
+            coordinate(l->getPoint(), l->getAxis(), ostr);
+            ostr << ")";
+        }
+        else
+            coordinate(l->getPoint(), l->getAxis(), ostr);
+        break;
+    }
+    case BaseFormula::T_CONST:
+    {
+        const Rational & c = constValue(n);
+        Rational a = c.isNegative() ? -c : c;
+        if(c.isNegative())
+            ostr << "(- ";
+        if(a.isInteger())
+            ostr << a;
+        else
+            ostr << "(/ " << a.numerator() << " " << a.denominator() << ")";
+        if(c.isNegative())
+            ostr << ")";
+        break;
+    }
+    case BaseFormula::T_PLUS:
+        ostr << "(+";
+        operands(n, ostr, true);
+        ostr << ")";
+        break;
+    case BaseFormula::T_TIMES:
+        ostr << "(*";
+        operands(n, ostr, true);
+        ostr << ")";
+        break;
+    case BaseFormula::T_AND:
+        ostr << "(and";
+        operands(n, ostr, true);
+        ostr << ")";
+        break;
+    case BaseFormula::T_OR:
+        ostr << "(or";
+        operands(n, ostr, true);
+        ostr << ")";
+        break;
+    case BaseFormula::T_MINUS:
+        ostr << "(-";
+        operands(n, ostr);
+        ostr << ")";
+        break;
+    case BaseFormula::T_POW:
+        ostr << "(*";
+        operands(n, ostr);
+        ostr << ")";
+        break;
+    case BaseFormula::T_EQ:
+        ostr << "(=";
+        operands(n, ostr);
+        ostr << ")";
+        break;
+    case BaseFormula::T_NOT:
+        ostr << "(not";
+        operands(n, ostr);
+        ostr << ")";
+        break;
+    default:
+        throw logic_error("unexpected node in coordinate language formula");
+    }
+}
+
+void SmtWriter::connectives(const Formula & f, BaseFormula::Type type, ostream & ostr)
+{
+    for(const Formula & op : {((BinaryConjective *)f)->getOperand1(),
+                              ((BinaryConjective *)f)->getOperand2()}) {
+        if(op->getType() == type)
+            connectives(op, type, ostr);
+        else {
+            ostr << " ";
+            formula(op, ostr);
+        }
+    }
+}
+
+void SmtWriter::formula(const Formula & f, ostream & ostr)
+{
+    switch(f->getType()){
+    case BaseFormula::T_TRUE:
+        ostr << "true";
+        break;
+    case BaseFormula::T_FALSE:
+        ostr << "false";
+        break;
+    case BaseFormula::T_NOT:
+        ostr << "(not ";
+        formula(((Not *)f)->getOperand(), ostr);
+        ostr << ")";
+        break;
+    case BaseFormula::T_AND:
+    case BaseFormula::T_OR:
+        ostr << (f->getType() == BaseFormula::T_AND ? "(and" : "(or");
+        connectives(f, f->getType(), ostr);
+        ostr << ")";
+        break;
+    case BaseFormula::T_IMP:
+    case BaseFormula::T_IFF:
+        ostr << (f->getType() == BaseFormula::T_IMP ? "(=> " : "(= ");
+        formula(((BinaryConjective *)f)->getOperand1(), ostr);
+        ostr << " ";
+        formula(((BinaryConjective *)f)->getOperand2(), ostr);
+        ostr << ")";
+        break;
+    case BaseFormula::T_FORALL:
+    case BaseFormula::T_EXISTS:
+    {
+        PointId v = ((Quantifier *)f)->getVariable();
+        ostr << (f->getType() == BaseFormula::T_FORALL ? "(forall ((" : "(exists ((");
+        coordinate(v, X, ostr);
+        ostr << " Real) (";
+        coordinate(v, Y, ostr);
+        ostr << " Real)) ";
+        formula(((Quantifier *)f)->getOperand(), ostr);
+        ostr << ")";
+        break;
+    }
+    case BaseFormula::T_ATOM:
+        // Disjednakost tacaka je negacija jednakosti.
+        if(dynamic_cast<Disequality *>(f) != nullptr) {
+            ostr << "(not ";
+            term(_atoms[f], ostr);
+            ostr << ")";
+        }
+        else
+            term(_atoms[f], ostr);
+        break;
+    default:
+        throw logic_error("unexpected node in formula");
+    }
+}
+
+void SmtWriter::write(const Formula & f, ostream & ostr)
+{
+    vector<PointId> scope;
+    translateAtoms(f, scope);
+    for(size_t i = 0; i < _roots.size(); i++) {
+        count(_roots[i]);
+        unordered_map<Formula, bool> seen;
+        quantified(_roots[i], _scopes[i], seen);
+    }
+
+    vector<vector<Formula> > levels;
+    for(const Formula & n : _order) {
+        Node & node = _nodes[n];
+        node.bound = node.refs > 1 && !isLeaf(n) && !node.quantified;
+    }
+    for(const Formula & n : _order) {
+        Node & node = _nodes[n];
+        if(!node.bound)
+            continue;
+        node.depth = innerDepth(n) + 1;
+        if((size_t)node.depth >= levels.size())
+            levels.resize(node.depth + 1);
+        levels[node.depth].push_back(n);
+    }
+
+    unsigned name = 0;
+    for(const auto & level : levels)
+        for(const Formula & n : level)
+            _nodes[n].name = name++;
+
+    ostr << "(set-logic " << (_quantifiers ? "NRA" : "QF_NRA") << ")\n";
+
+    for(Var v : _coordinates) {
+        ostr << "(declare-fun ";
+        coordinate(varPoint(v), varAxis(v), ostr);
+        ostr << " () Real)\n";
+    }
+
+    ostr << "(assert";
+    for(const auto & level : levels) {
+        ostr << "\n (let (";
+        for(unsigned i = 0; i < level.size(); i++) {
+            if(i > 0)
+                ostr << " ";
+            ostr << "(t" << _nodes[level[i]].name << " ";
+            term(level[i], ostr, true);
+            ostr << ")";
+        }
+        ostr << ")";
+    }
+    ostr << "\n ";
+    formula(f, ostr);
+    for(size_t i = 0; i < levels.size(); i++)
+        ostr << ")";
+    ostr << ")\n(check-sat)\n(reset)\n";
+}
+
+void writeSmtStatement(const Formula & f, TranslationContext & ctx, ostream & ostr)
+{
+    SmtWriter(ctx).write(f, ostr);
+}
+
+void writeSmtError(const string & message, ostream & ostr)
+{
+    ostr << "; " << message << "\n";
+}
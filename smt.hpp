@@ -0,0 +1,26 @@
+#ifndef _SMT_H
+#define _SMT_H
+
+#include "fol.hpp"
+
+/* Ispis prevoda kao SMT-LIB2 skripta (opcija --smt). Svaka naredba je
+   zaseban problem:
+
+     (set-logic QF_NRA)            NRA ako naredba ima kvantifikatore
+     (declare-fun a_x () Real) ... svaka slobodna koordinata jednom
+     (assert ...)
+     (check-sat)
+     (reset)
+
+   Atomi se prevode u isto stablo koordinatnog jezika kao u obicnom
+   ispisu. Cvorovi tog stabla su jedinstveni u celoj naredbi (vidi
+   nodefactory.hpp), pa se svaki podizraz koji se pojavljuje vise puta
+   ispisuje jednom i vezuje sa let. Podizrazi koji sadrze kvantifikovanu
+   promenljivu se ne vezuju, jer bi let izasao iz dosega kvantifikatora. */
+
+void writeSmtStatement(const Formula & f, TranslationContext & ctx, ostream & ostr);
+
+/* Poruka o neispravnoj naredbi kao SMT-LIB komentar. */
+void writeSmtError(const string & message, ostream & ostr);
+
+#endif // _SMT_H
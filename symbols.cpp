@@ -0,0 +1,58 @@
+#include "symbols.hpp"
+
+std::unordered_map<std::string_view, PointId> SymbolTable::_ids;
+std::deque<std::string> SymbolTable::_names;
+std::mutex SymbolTable::_mutex;
+thread_local std::unordered_map<std::string_view, PointId> SymbolTable::_localIds;
+thread_local std::vector<const std::string *> SymbolTable::_localNames;
+
+PointId SymbolTable::intern(std::string_view name)
+{
+    auto local = _localIds.find(name);
+    if(local != _localIds.end())
+        return local->second;
+
+    PointId id;
+    std::string_view stored;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto it = _ids.find(name);
+        if(it != _ids.end()) {
+            id = it->second;
+            stored = it->first;
+        }
+        else {
+            id = _names.size();
+            _names.emplace_back(name);
+            stored = _names.back();
+            _ids.emplace(stored, id);
+        }
+    }
+
+    _localIds.emplace(stored, id);
+    return id;
+}
+
+const std::string & SymbolTable::name(PointId id)
+{
+    if(id < _localNames.size() && _localNames[id] != nullptr)
+        return *_localNames[id];
+
+    const std::string * s;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        s = &_names[id];
+    }
+
+    if(id >= _localNames.size())
+        _localNames.resize(id + 1, nullptr);
+    _localNames[id] = s;
+    return *s;
+}
+
+size_t SymbolTable::size()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _names.size();
+}
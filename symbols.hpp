@@ -0,0 +1,50 @@
+#ifndef _SYMBOLS_H
+#define _SYMBOLS_H
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+typedef unsigned PointId;
+
+static const PointId NO_POINT = (PointId)-1;
+
+enum axis{
+    X,
+    Y
+};
+
+
+static const char * apendAxis(axis a){
+    if(a == X)
+        return "_x";
+    else
+        return "_y";
+}
+
+/* Tabela simbola tacaka. Svaka tacka pri parsiranju dobija gusti
+   celobrojni identifikator; ime se koristi samo pri ispisu. Tabela je
+   zajednicka za sve niti i zasticena je muteksom; imena se cuvaju u
+   deque, pa reference koje vraca name() ostaju vazece. Dodeljen
+   identifikator se vise ne menja, pa svaka nit pamti vec vidjene
+   parove i za njih ne zakljucava tabelu. Kljucevi mapa su pogledi na
+   imena iz deque, pa trazenje imena iz ulaza ne pravi kopiju. */
+class SymbolTable {
+public:
+    static PointId intern(std::string_view name);
+    static const std::string & name(PointId id);
+    static size_t size();
+
+private:
+    static std::unordered_map<std::string_view, PointId> _ids;
+    static std::deque<std::string> _names;
+    static std::mutex _mutex;
+
+    static thread_local std::unordered_map<std::string_view, PointId> _localIds;
+    static thread_local std::vector<const std::string *> _localNames;
+};
+
+#endif // _SYMBOLS_H
@@ -0,0 +1,245 @@
+#include "templates.hpp"
+#include "nodefactory.hpp"
+
+#include <cctype>
+#include <mutex>
+#include <stdexcept>
+
+vector<RelationTemplate> RelationTemplate::_templates;
+
+/* Jednacine relacija, po redosledu iz enum relation. */
+static const struct {
+    relation rel;
+    unsigned arity;
+    const char * text;
+} relationTable[] = {
+    { collinear,       3, "(0_x - 1_x) * (1_y - 2_y) = (0_y - 1_y) * (1_x - 2_x)" },
+    { parallel,        4, "(0_x - 1_x) * (2_y - 3_y) = (0_y - 1_y) * (2_x - 3_x)" },
+    { perpendicular,   4, "(0_x - 1_x) * (2_x - 3_x) + (0_y - 1_y) * (2_y - 3_y) = 0" },
+    { lengths_eq,      4, "(0_x - 1_x)^2 + (0_y - 1_y)^2 = (2_x - 3_x)^2 + (2_y - 3_y)^2" },
+    { is_midpoint,     3, "2 * 0_x = 1_x + 2_x & 2 * 0_y = 1_y + 2_y" },
+    { is_intersection, 5, "(0_x - 1_x) * (1_y - 2_y) = (0_y - 1_y) * (1_x - 2_x) & "
+                          "(0_x - 3_x) * (3_y - 4_y) = (0_y - 3_y) * (3_x - 4_x)" },
+    { is_equal,        2, "0_x = 1_x & 0_y = 1_y" }
+};
+
+/* Parser zapisa sablona:
+     conj := eq ('&' eq)*
+     eq   := sum '=' sum
+     sum  := prod (('+' | '-') prod)*
+     prod := pow ('*' pow)*
+     pow  := atom ('^2')?
+     atom := BROJ | BROJ '_x' | BROJ '_y' | '(' sum ')'
+   Operatori su levo asocijativni, kao u rucno pravljenim stablima. */
+class TemplateParser {
+public:
+    TemplateParser(const char * text)
+        :_s(text)
+    {}
+
+    Formula parse()
+    {
+        Formula f = conj();
+        skip();
+        if(*_s != '\0')
+            error();
+        return f;
+    }
+
+private:
+    const char * _s;
+
+    void error()
+    {
+        throw logic_error(string("bad relation template near: ") + _s);
+    }
+
+    void skip()
+    {
+        while(*_s == ' ')
+            _s++;
+    }
+
+    bool accept(char c)
+    {
+        skip();
+        if(*_s != c)
+            return false;
+        _s++;
+        return true;
+    }
+
+    Formula conj()
+    {
+        Formula f = eq();
+        while(accept('&'))
+            f = createAnd(f, eq());
+        return f;
+    }
+
+    Formula eq()
+    {
+        Formula lhs = sum();
+        if(!accept('='))
+            error();
+        return createEqual(lhs, sum());
+    }
+
+    Formula sum()
+    {
+        Formula f = prod();
+        while(true) {
+            if(accept('+'))
+                f = createPlus(f, prod());
+            else if(accept('-'))
+                f = createMinus(f, prod());
+            else
+                return f;
+        }
+    }
+
+    Formula prod()
+    {
+        Formula f = pow();
+        while(accept('*'))
+            f = createTimes(f, pow());
+        return f;
+    }
+
+    Formula pow()
+    {
+        Formula f = atom();
+        if(accept('^')) {
+            if(!accept('2'))
+                error();
+            f = createPow(f);
+        }
+        return f;
+    }
+
+    Formula atom()
+    {
+        if(accept('(')) {
+            Formula f = sum();
+            if(!accept(')'))
+                error();
+            return f;
+        }
+
+        skip();
+        if(!isdigit(*_s))
+            error();
+
+        unsigned n = 0;
+        while(isdigit(*_s))
+            n = 10 * n + (*_s++ - '0');
+
+        if(_s[0] == '_' && (_s[1] == 'x' || _s[1] == 'y')) {
+            axis a = _s[1] == 'x' ? X : Y;
+            _s += 2;
+            return createCoordinate(n, a);
+        }
+
+        return createConst(n);
+    }
+};
+
+/* Skuplja jednacine konjunkcije f kao polinome u kanonskom obliku. */
+static void collectEquations(const Formula & f, vector<Polynomial> & system)
+{
+    if(f->getType() == BaseFormula::T_AND) {
+        collectEquations(((And *)f)->getOperand1(), system);
+        collectEquations(((And *)f)->getOperand2(), system);
+    }
+    else {
+        system.push_back((toPolynomial(((Equal *)f)->getOperand1()) -
+                          toPolynomial(((Equal *)f)->getOperand2())).normalized());
+    }
+}
+
+RelationTemplate::RelationTemplate(unsigned arity, const char * text)
+    :_arity(arity)
+{
+    _formula = TemplateParser(text).parse();
+    collectEquations(_formula, _system);
+}
+
+void RelationTemplate::init()
+{
+    // Sabloni zive u sopstvenoj areni do kraja rada programa.
+    static Arena arena;
+    static once_flag once;
+
+    call_once(once, [] {
+        Arena * statementArena = Arena::current();
+        Arena::setCurrent(&arena);
+
+        for(const auto & r : relationTable) {
+            if(r.rel != (relation)_templates.size())
+                throw logic_error("relation table is not in enum order");
+            _templates.push_back(RelationTemplate(r.arity, r.text));
+        }
+
+        NodeFactory::clear();
+        Arena::setCurrent(statementArena);
+    });
+}
+
+Formula RelationTemplate::instantiate(Formula f, const vector<extendedPoint> & points) const
+{
+    switch(f->getType()){
+    case BaseFormula::T_LIT:
+    {
+        const Lit * l = (Lit *)f;
+        return points[l->getPoint()].coord(l->getAxis());
+    }
+    case BaseFormula::T_CONST:
+        return createConst(constValue(f));
+    case BaseFormula::T_POW:
+        return createPow(instantiate(((Pow *)f)->getOperand(), points));
+    default:
+        break;
+    }
+
+    Formula op1 = instantiate(((BinaryConjective *)f)->getOperand1(), points);
+    Formula op2 = instantiate(((BinaryConjective *)f)->getOperand2(), points);
+
+    switch(f->getType()){
+    case BaseFormula::T_PLUS:
+        return createPlus(op1, op2);
+    case BaseFormula::T_MINUS:
+        return createMinus(op1, op2);
+    case BaseFormula::T_TIMES:
+        return createTimes(op1, op2);
+    case BaseFormula::T_EQ:
+        return createEqual(op1, op2);
+    default:
+        return createAnd(op1, op2);
+    }
+}
+
+Formula RelationTemplate::instantiate(const vector<extendedPoint> & points) const
+{
+    return instantiate(_formula, points)->simple();
+}
+
+bool RelationTemplate::instantiate(const vector<extendedPoint> & points,
+                                   vector<Polynomial> & system) const
+{
+    vector<Var> vars(2 * _arity);
+    for(unsigned i = 0; i < _arity; i++) {
+        vars[coordinateVar(i, X)] = points[i].isZero(X) ? NO_VAR : coordinateVar(points[i].point, X);
+        vars[coordinateVar(i, Y)] = points[i].isZero(Y) ? NO_VAR : coordinateVar(points[i].point, Y);
+    }
+
+    for(const Polynomial & p : _system) {
+        Polynomial q = p.renamed(vars);
+        if(q.isZero())
+            continue;
+        if(q.isConstant())
+            return false;
+        system.push_back(q.normalized());
+    }
+
+    return true;
+}
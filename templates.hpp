@@ -0,0 +1,47 @@
+#ifndef _TEMPLATES_H
+#define _TEMPLATES_H
+
+#include "fol.hpp"
+
+/* Sablon prevoda jedne relacije. Jednacine su zapisane nad tackama
+   0..arity-1 (npr. "0_x" je x koordinata prve tacke), parsiraju se
+   jednom pri pokretanju, a prevod atoma je samo zamena tih tacaka
+   konkretnim tackama atoma. */
+class RelationTemplate {
+public:
+    /* Parsira sve sablone pre prve naredbe; ponovljeni pozivi (npr. iz
+       biblioteke, vidi algebrize.hpp) nemaju efekta. */
+    static void init();
+
+    static const RelationTemplate & get(relation rel)
+    {
+        return _templates[rel];
+    }
+
+    unsigned arity() const
+    {
+        return _arity;
+    }
+
+    /* Uprosceno stablo prevoda za konkretne tacke. */
+    Formula instantiate(const vector<extendedPoint> & points) const;
+
+    /* Sistem jednacina p = 0 u kanonskom obliku za konkretne tacke,
+       dobijen preimenovanjem promenljivih unapred razvijenih polinoma.
+       Vraca false ako je sistem protivrecan. */
+    bool instantiate(const vector<extendedPoint> & points,
+                     vector<Polynomial> & system) const;
+
+private:
+    RelationTemplate(unsigned arity, const char * text);
+
+    Formula instantiate(Formula f, const vector<extendedPoint> & points) const;
+
+    unsigned _arity;
+    Formula _formula;
+    vector<Polynomial> _system;
+
+    static vector<RelationTemplate> _templates;
+};
+
+#endif // _TEMPLATES_H
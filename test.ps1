@@ -11,3 +11,79 @@ for($i = 0; $i -le $testOutput.Count; $i++){
         write-host "expected: " $expectedOutput[$i]
     }
 }
+
+$testOutput = Get-Content test_input.txt | .\program.exe -p
+$expectedOutput = Get-Content .\test_expectedOutput_p.txt
+for($i = 0; $i -lt $expectedOutput.Count; $i++){
+    if($testOutput[$i] -eq $expectedOutput[$i]){
+        write-host "Normal form test $i succeeded"
+    }
+    else{
+        Write-Host "Normal form test $i failed : "
+        write-host "output:   " $testOutput[$i]
+        write-host "expected: " $expectedOutput[$i]
+    }
+}
+
+# Paralelni rezimi moraju dati isti izlaz kao redni, i u obicnom i u -p ispisu.
+function Test-SameOutput($name, $programArgs){
+    foreach($format in @("", "-p")){
+        $expectedOutput = (Get-Content test_input.txt | .\program.exe $format) -join "`n"
+        $testOutput = (Get-Content test_input.txt | .\program.exe $format @programArgs) -join "`n"
+        if($testOutput -ceq $expectedOutput){
+            write-host "$name test $format succeeded"
+        }
+        else{
+            Write-Host "$name test $format failed : output differs from the sequential run"
+        }
+    }
+}
+
+Test-SameOutput "Jobs" @("--jobs", "4")
+Test-SameOutput "Pipeline" @("--pipeline", "4")
+Test-SameOutput "Input" @("--input", "test_input.txt")
+Test-SameOutput "Pipeline input" @("--pipeline", "4", "--input", "test_input.txt")
+
+function Test-Prover($expectedFile, $programArgs){
+    $testOutput = Get-Content test_prove_input.txt | .\program.exe --prove @programArgs
+    $expectedOutput = Get-Content $expectedFile
+    for($i = 0; $i -lt $expectedOutput.Count; $i++){
+        if($testOutput[$i] -eq $expectedOutput[$i]){
+            write-host "Prove test $i ($expectedFile) succeeded"
+        }
+        else{
+            Write-Host "Prove test $i ($expectedFile) failed : "
+            write-host "output:   " $testOutput[$i]
+            write-host "expected: " $expectedOutput[$i]
+        }
+    }
+}
+
+Test-Prover .\test_prove_expectedOutput.txt @()
+Test-Prover .\test_prove_expectedOutput_f4.txt @("--engine", "f4")
+Test-Prover .\test_prove_expectedOutput_f4_modular.txt @("--engine", "f4", "--modular")
+Test-Prover .\test_prove_expectedOutput_wu.txt @("--engine", "wu")
+Test-Prover .\test_prove_expectedOutput_random.txt @("--engine", "random")
+
+g++ -std=c++17 -O2 tests\rational_test.cpp rational.cpp bigint.cpp -o rational_test.exe
+.\rational_test.exe
+
+# Binarni zapis se pise u datoteku bez prolaska kroz PowerShell
+# cevovod, koji bi ga prekodirao.
+Start-Process .\program.exe -ArgumentList "-b" -RedirectStandardInput test_input.txt -RedirectStandardOutput test_output.bin -NoNewWindow -Wait
+g++ -std=c++17 -O2 tests\binary_test.cpp binreader.cpp -o binary_test.exe
+$testOutput = .\binary_test.exe test_output.bin
+$expectedOutput = Get-Content test_input.txt | .\program.exe -p
+for($i = 0; $i -lt $testOutput.Count; $i++){
+    if($testOutput[$i] -eq $expectedOutput[$i]){
+        write-host "Binary test $i succeeded"
+    }
+    else{
+        Write-Host "Binary test $i failed : "
+        write-host "output:   " $testOutput[$i]
+        write-host "expected: " $expectedOutput[$i]
+    }
+}
+if($testOutput.Count -eq 0){
+    Write-Host "Binary test failed : no output"
+}
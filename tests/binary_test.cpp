@@ -0,0 +1,149 @@
+#include "../binreader.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+/* Cita binarni zapis (opcija -b) iz datoteke i ispisuje naredbe u
+   obliku opcije -p, pa test.ps1 poredi ispis sa izlazom programa sa
+   -p. Zagrade oko veznika se stavljaju kao u printConvertedFormula. */
+
+static void polynomial(const BinaryReader & reader, const BinaryPolynomial & p)
+{
+    for(unsigned i = 0; i < p.size(); i++) {
+        const BinaryMonomial & m = p[i];
+        bool negative = m.num < 0;
+
+        if(i == 0) {
+            if(negative)
+                std::cout << "-";
+        }
+        else
+            std::cout << (negative ? " - " : " + ");
+
+        uint64_t num = negative ? 0 - (uint64_t)m.num : (uint64_t)m.num;
+        bool one = num == 1 && m.den == 1;
+
+        if(m.factors.empty() || !one) {
+            std::cout << num;
+            if(m.den != 1)
+                std::cout << "/" << m.den;
+            if(!m.factors.empty())
+                std::cout << "*";
+        }
+
+        for(unsigned j = 0; j < m.factors.size(); j++) {
+            if(j > 0)
+                std::cout << "*";
+            std::cout << reader.variableName(m.factors[j].first);
+            if(m.factors[j].second > 1)
+                std::cout << "^" << m.factors[j].second;
+        }
+    }
+}
+
+static bool connective(const BinaryFormula & f)
+{
+    return f.tag == BIN_AND || f.tag == BIN_OR || f.tag == BIN_IMP || f.tag == BIN_IFF;
+}
+
+/* Prednost veznika; operand slabijeg veznika ide u zagrade, a desni
+   operand istog veznika takodje. */
+static int precedence(binaryTag tag)
+{
+    switch(tag){
+    case BIN_AND:
+        return 3;
+    case BIN_OR:
+        return 2;
+    case BIN_IMP:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+static void formula(const BinaryReader & reader, const BinaryFormula & f);
+
+static void operand(const BinaryReader & reader, const BinaryFormula & f, bool parens)
+{
+    if(parens)
+        std::cout << "(";
+    formula(reader, f);
+    if(parens)
+        std::cout << ")";
+}
+
+static void formula(const BinaryReader & reader, const BinaryFormula & f)
+{
+    switch(f.tag){
+    case BIN_TRUE:
+        std::cout << "true";
+        break;
+    case BIN_FALSE:
+        std::cout << "false";
+        break;
+    case BIN_NOT:
+        std::cout << "~";
+        operand(reader, f.operands[0], connective(f.operands[0]));
+        break;
+    case BIN_AND:
+    case BIN_OR:
+    case BIN_IMP:
+    case BIN_IFF:
+    {
+        const BinaryFormula & op1 = f.operands[0];
+        const BinaryFormula & op2 = f.operands[1];
+        int p = precedence(f.tag);
+        operand(reader, op1, connective(op1) && precedence(op1.tag) < p);
+        std::cout << (f.tag == BIN_AND ? " & " : f.tag == BIN_OR ? " | " :
+                      f.tag == BIN_IMP ? " => " : " <=> ");
+        operand(reader, op2, connective(op2) && precedence(op2.tag) <= p);
+        break;
+    }
+    case BIN_FORALL:
+    case BIN_EXISTS:
+        std::cout << (f.tag == BIN_FORALL ? "![" : "?[") << reader.pointName(f.variable) << "] : ";
+        operand(reader, f.operands[0], connective(f.operands[0]));
+        break;
+    case BIN_SYSTEM:
+        for(unsigned i = 0; i < f.system.size(); i++) {
+            if(i > 0)
+                std::cout << " & ";
+            polynomial(reader, f.system[i]);
+            std::cout << " = 0";
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    if(argc != 2) {
+        std::cerr << "USE: binary_test FILE" << std::endl;
+        return 1;
+    }
+
+    std::ifstream in(argv[1], std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    try {
+        BinaryReader reader(data.data(), data.size());
+        BinaryStatement statement;
+        while(reader.next(statement)) {
+            if(statement.error)
+                std::cout << statement.message;
+            else
+                formula(reader, statement.formula);
+            std::cout << "\n";
+        }
+    }
+    catch(const std::exception & e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include "../rational.hpp"
+
+#include <iostream>
+#include <sstream>
+
+/* Provere za Rational i BigInt oko granice od 64 bita: vrednosti koje
+   tek ne staju u mali oblik i povratak iz velikog oblika u mali. */
+
+static unsigned failed = 0;
+static unsigned count = 0;
+
+static void check(const char * name, bool ok)
+{
+    if(ok)
+        std::cout << "Test " << count << " succeeded" << std::endl;
+    else {
+        std::cout << "Test " << count << " failed : " << name << std::endl;
+        failed++;
+    }
+    count++;
+}
+
+static std::string str(const Rational & r)
+{
+    std::ostringstream ostr;
+    ostr << r;
+    return ostr.str();
+}
+
+static std::string str(const BigInt & b)
+{
+    return b.toString();
+}
+
+int main()
+{
+    // -INT64_MIN ne staje u int64_t.
+    Rational minimum(INT64_MIN);
+    check("INT64_MIN value", str(minimum) == "-9223372036854775808");
+    check("-INT64_MIN", str(-minimum) == "9223372036854775808" && !(-minimum).isSmall());
+    check("-(-INT64_MIN)", -(-minimum) == minimum);
+    check("INT64_MIN / -1", Rational(INT64_MIN, -1) == -minimum);
+    check("INT64_MIN / INT64_MIN", Rational(INT64_MIN, INT64_MIN).isOne());
+    check("1 / INT64_MIN", str(Rational(1, INT64_MIN)) == "-1/9223372036854775808");
+    check("INT64_MIN + 1", (minimum + 1) == Rational(-INT64_MAX) && (minimum + 1).isSmall());
+
+    BigInt bigMinimum(INT64_MIN);
+    int64_t value;
+    // toInt64 prihvata samo |x| <= INT64_MAX, kao mali oblik Rational-a.
+    check("BigInt INT64_MIN", !bigMinimum.toInt64(value) && str(bigMinimum) == "-9223372036854775808");
+    check("BigInt -INT64_MAX", BigInt(-INT64_MAX).toInt64(value) && value == -INT64_MAX);
+    check("BigInt -INT64_MIN", !(-bigMinimum).toInt64(value) &&
+          str(-bigMinimum) == "9223372036854775808");
+    check("BigInt INT64_MIN / -1", bigMinimum / BigInt(-1) == -bigMinimum);
+
+    // Proizvodi koji tek predju 64 bita.
+    Rational maximum(INT64_MAX);
+    check("INT64_MAX * 2", str(maximum * 2) == "18446744073709551614" && !(maximum * 2).isSmall());
+    check("INT64_MAX + 1", str(maximum + 1) == "9223372036854775808" && !(maximum + 1).isSmall());
+    check("2^31 * 2^32", !(Rational(1LL << 31) * Rational(1LL << 32)).isSmall());
+    check("2^31 * 2^31", (Rational(1LL << 31) * Rational(1LL << 31)).isSmall());
+    check("-2^32 * 2^31", !(Rational(-(1LL << 32)) * Rational(1LL << 31)).isSmall());
+    check("1/INT64_MAX * 1/2", str(Rational(1, INT64_MAX) * Rational(1, 2)) == "1/18446744073709551614");
+    check("3037000500^2", str(Rational(3037000500LL) * Rational(3037000500LL)) == "9223372037000250000");
+    check("3037000499^2", (Rational(3037000499LL) * Rational(3037000499LL)).isSmall());
+
+    BigInt product = BigInt(INT64_MAX) * BigInt(INT64_MAX);
+    check("BigInt INT64_MAX^2", str(product) == "85070591730234615847396907784232501249");
+    check("BigInt INT64_MAX^2 / INT64_MAX", product / BigInt(INT64_MAX) == BigInt(INT64_MAX));
+
+    // Prelazak u veliki oblik i povratak u mali.
+    Rational a(3037000499LL);
+    Rational cube = a * a * a;
+    check("spill", !cube.isSmall());
+    Rational back = cube / a / a;
+    check("shrink", back == a && back.isSmall() && back.num() == 3037000499LL);
+
+    Rational sum = maximum + maximum - maximum;
+    check("sum round trip", sum == maximum && sum.isSmall());
+
+    Rational fraction = Rational(1, INT64_MAX) * Rational(1, 3);
+    check("fraction spill", !fraction.isSmall());
+    Rational restored = fraction * 3;
+    check("fraction shrink", restored == Rational(1, INT64_MAX) && restored.isSmall());
+    check("big numerator", fraction.numerator().isOne() && !fraction.denominator().isSmall());
+
+    check("big comparison", maximum < maximum + 1 && -(maximum + 1) < minimum + 1 &&
+          !(maximum * 2 < maximum * 2));
+    check("big hash", (maximum * 2).hash() == (maximum + maximum).hash());
+
+    Rational copy = maximum * 2;
+    Rational moved = std::move(copy);
+    copy = moved;
+    check("big copy", copy == moved && str(copy) == "18446744073709551614");
+
+    bool thrown = false;
+    try {
+        (maximum * 2).num();
+    }
+    catch(const std::overflow_error &) {
+        thrown = true;
+    }
+    check("num of big value", thrown);
+
+    return failed == 0 ? 0 : 1;
+}
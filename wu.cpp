@@ -0,0 +1,140 @@
+#include "wu.hpp"
+
+#include <algorithm>
+
+unsigned CharacteristicSet::degree(const Polynomial & p, Var x)
+{
+    unsigned d = 0;
+    for(const auto & t : p.terms())
+        d = max(d, t.first.exponent(x));
+    return d;
+}
+
+Polynomial CharacteristicSet::coefficient(const Polynomial & p, Var x, unsigned d)
+{
+    Polynomial::Terms terms;
+    for(const auto & t : p.terms()) {
+        if(t.first.exponent(x) != d)
+            continue;
+
+        terms.push_back(Polynomial::Term(d > 0 ? t.first / Monomial::variable(x, d) : t.first,
+                                         t.second));
+    }
+
+    // Deljenje svih termova istim monomom ne menja njihov poredak.
+    return Polynomial(move(terms));
+}
+
+CharacteristicSet::CharacteristicSet(const vector<Var> & variables)
+{
+    for(unsigned i = 0; i < variables.size(); i++) {
+        if(variables[i] >= _rank.size())
+            _rank.resize(variables[i] + 1, -1);
+        _rank[variables[i]] = i;
+    }
+}
+
+Var CharacteristicSet::mainVariable(const Polynomial & p) const
+{
+    Var main = NO_VAR;
+    for(const auto & t : p.terms())
+        for(const auto & f : t.first.factors())
+            if(main == NO_VAR || rank(f.first) > rank(main) ||
+                    (rank(f.first) == rank(main) && f.first < main))
+                main = f.first;
+    return main;
+}
+
+Polynomial CharacteristicSet::pseudoRemainder(const Polynomial & g, const Polynomial & f, Var x)
+{
+    unsigned d = degree(f, x);
+    Polynomial initial = coefficient(f, x, d);
+
+    Polynomial r = g;
+    while(!r.isZero()) {
+        unsigned e = degree(r, x);
+        if(e < d)
+            break;
+
+        Polynomial lc = coefficient(r, x, e);
+        r = r * initial - lc * f * Polynomial(Monomial::variable(x, e - d));
+    }
+
+    return r.normalized();
+}
+
+bool CharacteristicSet::triangulate(const vector<Polynomial> & hypotheses)
+{
+    _chain.clear();
+
+    vector<Polynomial> pool;
+    for(const Polynomial & h : hypotheses)
+        if(!h.isZero())
+            pool.push_back(h.normalized());
+
+    while(!pool.empty()) {
+        // Polinomi sa najvisom glavnom promenljivom x se svode na jedan,
+        // kao u Euklidovom algoritmu: ostali se pseudo-dele onim koji
+        // je najnizeg stepena po x.
+        Var x = NO_VAR;
+        for(const Polynomial & p : pool) {
+            Var v = mainVariable(p);
+            if(v == NO_VAR)
+                return false;
+            if(x == NO_VAR || rank(v) > rank(x) || (rank(v) == rank(x) && v < x))
+                x = v;
+        }
+
+        vector<Polynomial> current, rest;
+        for(const Polynomial & p : pool)
+            (mainVariable(p) == x ? current : rest).push_back(p);
+
+        while(current.size() > 1) {
+            auto lowest = min_element(current.begin(), current.end(),
+                                      [x](const Polynomial & p1, const Polynomial & p2) {
+                return degree(p1, x) < degree(p2, x);
+            });
+            Polynomial divisor = *lowest;
+            current.erase(lowest);
+
+            vector<Polynomial> next(1, divisor);
+            for(const Polynomial & q : current) {
+                Polynomial r = pseudoRemainder(q, divisor, x);
+                if(r.isZero())
+                    continue;
+                (mainVariable(r) == x ? next : rest).push_back(r);
+            }
+            current.swap(next);
+        }
+
+        _chain.push_back(current[0]);
+        pool.swap(rest);
+    }
+
+    return true;
+}
+
+vector<Polynomial> CharacteristicSet::initials() const
+{
+    vector<Polynomial> result;
+    for(const Polynomial & f : _chain) {
+        Var x = mainVariable(f);
+        Polynomial initial = coefficient(f, x, degree(f, x)).normalized();
+        if(initial.isConstant())
+            continue;
+        if(find(result.begin(), result.end(), initial) == result.end())
+            result.push_back(initial);
+    }
+    return result;
+}
+
+Polynomial CharacteristicSet::remainder(const Polynomial & p) const
+{
+    Polynomial r = p;
+    for(const Polynomial & f : _chain) {
+        if(r.isZero())
+            break;
+        r = pseudoRemainder(r, f, mainVariable(f));
+    }
+    return r;
+}
@@ -0,0 +1,65 @@
+#ifndef _WU_H
+#define _WU_H
+
+#include <vector>
+
+#include "polynomial.hpp"
+
+using namespace std;
+
+/* Wuov metod: hipoteze se uzastopnim pseudo-deljenjem svode na
+   trougaoni skup f1, ..., fk, u kome svaki polinom ima drugu glavnu
+   promenljivu (najvisu promenljivu koja se u njemu javlja). Zakljucak
+   vazi ako je njegov pseudo-ostatak u odnosu na trougaoni skup nula,
+   uz uslove nedegenerisanosti: inicijali (vodeci koeficijenti po
+   glavnoj promenljivoj) polinoma fi su razliciti od nule.
+
+   Promenljive se uredjuju redom konstrukcije (PolynomialSystem::
+   variables): kasnije konstruisane tacke su vise. */
+class CharacteristicSet {
+public:
+    /* variables: redom od najnize ka najvisoj promenljivoj. Promenljive
+       kojih nema na spisku su nize od svih sa spiska. */
+    CharacteristicSet(const vector<Var> & variables);
+
+    /* Pravi trougaoni skup; vraca false ako se iz hipoteza dobije
+       konstanta razlicita od nule, tj. ako su protivrecne. */
+    bool triangulate(const vector<Polynomial> & hypotheses);
+
+    /* Trougaoni skup, od najvise glavne promenljive ka najnizoj. */
+    const vector<Polynomial> & chain() const
+    {
+        return _chain;
+    }
+
+    /* Inicijali trougaonog skupa koji nisu konstante, bez ponavljanja. */
+    vector<Polynomial> initials() const;
+
+    /* Pseudo-ostatak p redom po svim polinomima trougaonog skupa. */
+    Polynomial remainder(const Polynomial & p) const;
+
+    /* Glavna promenljiva p, ili NO_VAR ako je p konstanta. */
+    Var mainVariable(const Polynomial & p) const;
+
+    /* Pseudo-ostatak g pri deljenju sa f po promenljivoj x: I^s * g =
+       q * f + r, gde je I inicijal f i deg_x r < deg_x f. Ostatak se
+       vraca u kanonskom obliku (vidi Polynomial::normalized). */
+    static Polynomial pseudoRemainder(const Polynomial & g, const Polynomial & f, Var x);
+
+    /* Stepen p po promenljivoj x. */
+    static unsigned degree(const Polynomial & p, Var x);
+
+    /* Koeficijent uz x^d, kao polinom u ostalim promenljivim. */
+    static Polynomial coefficient(const Polynomial & p, Var x, unsigned d);
+
+private:
+    int rank(Var v) const
+    {
+        return v < _rank.size() ? _rank[v] : -1;
+    }
+
+    vector<int> _rank;
+    vector<Polynomial> _chain;
+};
+
+#endif // _WU_H